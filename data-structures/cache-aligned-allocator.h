@@ -0,0 +1,27 @@
+#ifndef CLASS_CACHE_ALIGNED_ALLOCATOR
+#define CLASS_CACHE_ALIGNED_ALLOCATOR
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+template <class type>
+class cache_aligned_allocator {
+	// allocator whose memory starts at a cache line boundary (64 bytes)
+public:
+	typedef type value_type;
+	cache_aligned_allocator() {};
+	template <class other> cache_aligned_allocator(const cache_aligned_allocator<other>&) {};
+	type* allocate(std::size_t count) {
+		// the original pointer is kept just before the aligned memory
+		char* raw = static_cast<char*>(::operator new(count * sizeof(type) + 64 + sizeof(void*)));
+		char* aligned = raw + sizeof(void*) + (64 - reinterpret_cast<std::uintptr_t>(raw + sizeof(void*)) % 64) % 64;
+		reinterpret_cast<void**>(aligned)[-1] = raw;
+		return reinterpret_cast<type*>(aligned);
+	}
+	void deallocate(type* ptr, std::size_t) { ::operator delete(reinterpret_cast<void**>(ptr)[-1]); }
+	template <class other> bool operator==(const cache_aligned_allocator<other>&) const { return true; }
+	template <class other> bool operator!=(const cache_aligned_allocator<other>&) const { return false; }
+};
+
+#endif // CLASS_CACHE_ALIGNED_ALLOCATOR
\ No newline at end of file
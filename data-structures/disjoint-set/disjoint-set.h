@@ -1,20 +1,31 @@
 #ifndef CLASS_DISJOINT_SET
 #define CLASS_DISJOINT_SET
 
+#include <atomic>
+#include <thread>
 #include <vector>
+#include <cassert>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <type_traits>
 #include <algorithm>
+#include <functional>
 
-class disjoint_set {
+template <class index_type>
+class basic_disjoint_set {
+	// index_type is a signed integer: a root stores -(size of group), and other elements store the parent
+public:
+	typedef index_type value_type;
 private:
-	typedef std::int32_t value_type;
 	std::vector<value_type> val;
 public:
-	explicit disjoint_set() : val() {};
-	explicit disjoint_set(std::size_t n) : val(n, -1) {};
+	explicit basic_disjoint_set() : val() {};
+	explicit basic_disjoint_set(std::size_t n) : val(n, -1) {
+		assert(std::uint64_t(n) <= std::uint64_t(std::numeric_limits<value_type>::max()) + 1);
+	};
 	std::size_t size() const { return val.size(); }
-	std::size_t size(std::size_t elem) { return std::size_t(-val[root(elem)]); }
+	std::size_t size(std::size_t elem) { return std::size_t(-std::int64_t(val[root(elem)])); }
 	std::size_t root(std::size_t elem) {
 		// path halving
 		while (val[elem] >= 0 && val[val[elem]] >= 0) {
@@ -31,11 +42,227 @@ public:
 			std::swap(elemx, elemy);
 		}
 		val[elemx] += val[elemy];
-		val[elemy] = elemx;
+		val[elemy] = value_type(elemx);
+	}
+	bool connected(std::size_t elemx, std::size_t elemy) {
+		return root(elemx) == root(elemy);
+	}
+};
+
+typedef basic_disjoint_set<std::int32_t> disjoint_set;
+
+template <class word_type>
+class packed_disjoint_set {
+	// Union by rank in one unsigned word per element: the top 64 values of word_type are reserved for roots, which store ~rank
+	// Other elements store the parent, so uint32_t holds up to 2^32 - 64 elements in 4 bytes each
+public:
+	typedef word_type value_type;
+private:
+	static_assert(std::is_unsigned<word_type>::value, "word_type must be unsigned");
+	static constexpr std::uint64_t rank_codes = 64;
+	std::vector<word_type> val;
+	static bool is_root(word_type word) { return word > word_type(std::numeric_limits<word_type>::max() - rank_codes); }
+public:
+	explicit packed_disjoint_set() : val() {};
+	explicit packed_disjoint_set(std::size_t n) : val(n, std::numeric_limits<word_type>::max()) {
+		assert(std::uint64_t(n) <= std::uint64_t(std::numeric_limits<word_type>::max()) - (rank_codes - 1));
+	};
+	std::size_t size() const { return val.size(); }
+	std::size_t root(std::size_t elem) {
+		// path halving
+		while (!is_root(val[elem])) {
+			word_type par = val[elem];
+			if (is_root(val[par])) return par;
+			val[elem] = val[par];
+			elem = val[elem];
+		}
+		return elem;
+	}
+	void link(std::size_t elemx, std::size_t elemy) {
+		elemx = root(elemx);
+		elemy = root(elemy);
+		if (elemx == elemy) return;
+		// a larger rank is a smaller code
+		if (val[elemx] > val[elemy]) {
+			std::swap(elemx, elemy);
+		}
+		if (val[elemx] == val[elemy]) --val[elemx];
+		val[elemy] = word_type(elemx);
 	}
 	bool connected(std::size_t elemx, std::size_t elemy) {
 		return root(elemx) == root(elemy);
 	}
 };
 
+class rollback_disjoint_set {
+	// Union-find with undo: union by size without path compression, so each link() can be rolled back in O(1)
+private:
+	typedef std::int32_t value_type;
+	std::vector<value_type> val;
+	std::vector<std::pair<value_type, value_type> > history; // (linked root, its value before the link)
+public:
+	explicit rollback_disjoint_set() : val(), history() {};
+	explicit rollback_disjoint_set(std::size_t n) : val(n, -1), history() {};
+	std::size_t size() const { return val.size(); }
+	std::size_t size(std::size_t elem) const { return std::size_t(-val[root(elem)]); }
+	std::size_t root(std::size_t elem) const {
+		while (val[elem] >= 0) elem = val[elem];
+		return elem;
+	}
+	bool link(std::size_t elemx, std::size_t elemy) {
+		// returns true if two different groups are merged (only such links are recorded)
+		elemx = root(elemx);
+		elemy = root(elemy);
+		if (elemx == elemy) return false;
+		if (val[elemx] > val[elemy]) {
+			std::swap(elemx, elemy);
+		}
+		history.push_back(std::make_pair(value_type(elemy), val[elemy]));
+		val[elemx] += val[elemy];
+		val[elemy] = elemx;
+		return true;
+	}
+	bool connected(std::size_t elemx, std::size_t elemy) const {
+		return root(elemx) == root(elemy);
+	}
+	std::size_t snapshot() const { return history.size(); }
+	void undo() {
+		assert(!history.empty());
+		value_type elemy = history.back().first, elemx = val[elemy];
+		val[elemx] -= history.back().second;
+		val[elemy] = history.back().second;
+		history.pop_back();
+	}
+	void rollback(std::size_t snapshot_id) {
+		// undoes all links after snapshot() returned snapshot_id
+		assert(snapshot_id <= history.size());
+		while (history.size() > snapshot_id) undo();
+	}
+};
+
+class concurrent_disjoint_set {
+	// Lock-free union-find: every operation may be called from any number of threads at the same time
+private:
+	typedef std::uint32_t value_type;
+	std::vector<std::atomic<value_type> > val;
+	bool randomized;
+	static value_type priority(value_type elem) {
+		// fixed pseudo-random permutation of the indices (bijective, so no ties)
+		elem ^= elem >> 16; elem *= 0x85ebca6bu;
+		elem ^= elem >> 13; elem *= 0xc2b2ae35u;
+		elem ^= elem >> 16;
+		return elem;
+	}
+	bool before(value_type elemx, value_type elemy) const {
+		// returns if root elemx should stay on top of root elemy
+		return randomized ? priority(elemx) < priority(elemy) : elemx < elemy;
+	}
+	template <class RandomAccessIterator>
+	friend std::vector<std::uint32_t> connected_components(std::size_t n, RandomAccessIterator first, RandomAccessIterator last, unsigned threads);
+public:
+	explicit concurrent_disjoint_set() : val(), randomized(true) {};
+	explicit concurrent_disjoint_set(std::size_t n, bool randomized_ = true) : val(n), randomized(randomized_) {
+		assert(std::uint64_t(n) <= std::uint64_t(std::numeric_limits<value_type>::max()) + 1);
+		for (std::size_t i = 0; i < n; ++i) val[i].store(value_type(i), std::memory_order_relaxed);
+	}
+	std::size_t size() const { return val.size(); }
+	std::size_t root(std::size_t elem) {
+		// path halving; cur is not a root here, and any ancestor is a valid parent of it, so a plain store is enough even if it races
+		value_type cur = value_type(elem);
+		while (true) {
+			value_type par = val[cur].load(std::memory_order_acquire);
+			value_type grand = val[par].load(std::memory_order_acquire);
+			if (par == grand) return par;
+			val[cur].store(grand, std::memory_order_release);
+			cur = grand;
+		}
+	}
+	bool link(std::size_t elemx, std::size_t elemy) {
+		// returns true if this call merged two different groups
+		value_type x = value_type(elemx), y = value_type(elemy);
+		while (true) {
+			x = value_type(root(x));
+			y = value_type(root(y));
+			if (x == y) return false;
+			if (before(x, y)) std::swap(x, y);
+			value_type expected = x;
+			if (val[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel)) return true;
+		}
+	}
+	bool connected(std::size_t elemx, std::size_t elemy) {
+		value_type x = value_type(elemx), y = value_type(elemy);
+		while (true) {
+			x = value_type(root(x));
+			y = value_type(root(y));
+			if (x == y) return true;
+			// x was a root both before and after y was found to be a root, so they were disjoint at that moment
+			if (val[x].load(std::memory_order_acquire) == x) return false;
+		}
+	}
+};
+
+template <class RandomAccessIterator>
+std::vector<std::uint32_t> connected_components(std::size_t n, RandomAccessIterator first, RandomAccessIterator last, unsigned threads) {
+	// Afforest-style bulk union-find: [first, last) is a list of edges (pairs of elements, accessed by .first and .second)
+	// Returns the component ID of each element; IDs are 0, 1, 2, ... in order of the smallest element of each component
+	if (threads == 0) threads = 1;
+	std::size_t m = last - first;
+	concurrent_disjoint_set uf(n, false);
+	std::vector<std::atomic<std::uint32_t> >& val = uf.val;
+	auto parallel = [&](std::size_t count, std::function<void(std::size_t, std::size_t, std::size_t)> func) {
+		// runs func(chunk_id, l, r) for [0, count) split into (threads) chunks
+		std::vector<std::thread> workers;
+		for (std::size_t t = 1; t < threads; ++t) workers.push_back(std::thread(func, t, count * t / threads, count * (t + 1) / threads));
+		func(0, 0, count / threads);
+		for (std::thread& worker : workers) worker.join();
+	};
+	auto compress = [&](std::size_t, std::size_t l, std::size_t r) {
+		for (std::size_t i = l; i < r; ++i) val[i].store(std::uint32_t(uf.root(i)), std::memory_order_relaxed);
+	};
+	// Step 1: link a sample of the edges, which is usually enough to form the giant component
+	std::size_t stride = std::max<std::size_t>(2, m / std::max<std::size_t>(n, 1));
+	parallel(m / stride + 1, [&](std::size_t, std::size_t l, std::size_t r) {
+		for (std::size_t i = l * stride; i < r * stride && i < m; i += stride) uf.link(first[i].first, first[i].second);
+	});
+	parallel(n, compress);
+	// Step 2: link the rest, skipping the edges whose endpoints already share the same parent (mostly inside the giant component)
+	parallel(m, [&](std::size_t, std::size_t l, std::size_t r) {
+		for (std::size_t i = l; i < r; ++i) {
+			if (i % stride == 0) continue;
+			std::size_t u = first[i].first, v = first[i].second;
+			if (val[u].load(std::memory_order_relaxed) == val[v].load(std::memory_order_relaxed)) continue;
+			uf.link(u, v);
+		}
+	});
+	// Step 3: find every root without writing to val (path halving would race with the other chunks and could leave a non-root parent),
+	// and only then relabel; since the root of each component is its smallest element, roots get IDs in increasing order
+	std::vector<std::uint32_t> rep(n), label(n);
+	std::vector<std::size_t> base(threads + 1);
+	parallel(n, [&](std::size_t chunk, std::size_t l, std::size_t r) {
+		for (std::size_t i = l; i < r; ++i) {
+			std::uint32_t cur = std::uint32_t(i), par;
+			while ((par = val[cur].load(std::memory_order_relaxed)) != cur) cur = par;
+			rep[i] = cur;
+			base[chunk + 1] += (cur == i);
+		}
+	});
+	for (std::size_t t = 0; t < threads; ++t) base[t + 1] += base[t];
+	parallel(n, [&](std::size_t chunk, std::size_t l, std::size_t r) {
+		std::uint32_t cur = std::uint32_t(base[chunk]);
+		for (std::size_t i = l; i < r; ++i) {
+			if (rep[i] == i) label[i] = cur++;
+		}
+	});
+	parallel(n, [&](std::size_t, std::size_t l, std::size_t r) {
+		for (std::size_t i = l; i < r; ++i) {
+			if (rep[i] != i) label[i] = label[rep[i]];
+		}
+	});
+	return label;
+}
+template <class RandomAccessIterator>
+std::vector<std::uint32_t> connected_components(std::size_t n, RandomAccessIterator first, RandomAccessIterator last) {
+	return connected_components(n, first, last, std::thread::hardware_concurrency());
+}
+
 #endif // CLASS_DISJOINT_SET
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include "dynamic-connectivity.h"
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+void test(int n, int q) {
+	// q operations: 40% add-edge, 20% remove-edge (of a random alive edge), 40% connected
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	offline_dynamic_connectivity dc(n);
+	vector<pair<int, int> > edges;
+	for(int i = 0; i < q; ++i) {
+		unsigned type = xorshift32() % 5;
+		if(type <= 1 || (type == 2 && edges.empty())) {
+			int a = xorshift32() % n, b = xorshift32() % n;
+			dc.add_edge(a, b);
+			edges.push_back(make_pair(a, b));
+		}
+		else if(type == 2) {
+			int pos = xorshift32() % edges.size();
+			swap(edges[pos], edges.back());
+			dc.remove_edge(edges.back().first, edges.back().second);
+			edges.pop_back();
+		}
+		else {
+			dc.connected(xorshift32() % n, xorshift32() % n);
+		}
+	}
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	vector<bool> res = dc.solve();
+	long long sum = 0;
+	for(int i = 0; i < int(res.size()); ++i) {
+		sum += res[i] ? i : 0;
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> register_duration = mid - start;
+	std::chrono::duration<double> solve_duration = finish - mid;
+	cout << "---------- TEST RESUTLTS (# of Elements = " << n << ", # of Operations = " << q << ") ----------" << endl;
+	cout << "Debug Answer: " << sum << endl;
+	cout << fixed << "Registering: " << register_duration.count() << " seconds (" << register_duration.count() / q << " seconds per operation)" << endl;
+	cout << fixed << "Solving: " << solve_duration.count() << " seconds (" << solve_duration.count() / q << " seconds per operation)" << endl;
+}
+int main() {
+	for(int i = 12; i <= 22; ++i) {
+		test(1 << i, 1 << i);
+	}
+	return 0;
+}
\ No newline at end of file
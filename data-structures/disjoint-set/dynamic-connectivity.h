@@ -0,0 +1,93 @@
+#ifndef CLASS_DYNAMIC_CONNECTIVITY
+#define CLASS_DYNAMIC_CONNECTIVITY
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include "disjoint-set.h"
+
+class offline_dynamic_connectivity {
+	// Offline dynamic connectivity: each edge is alive in an interval of time, and the intervals are put on a segment tree over queries
+	// Traversing the segment tree with rollback_disjoint_set answers all queries in O(q log q log n)
+private:
+	std::size_t n;
+	std::vector<std::uint32_t> qa, qb; // endpoints of connected() queries
+	std::vector<std::uint32_t> ea, eb, el, er; // endpoints of edges, and alive in queries [el, er)
+	std::unordered_map<std::uint64_t, std::vector<std::uint32_t> > alive; // edge key -> indices of edges not removed yet
+	std::size_t sz;
+	std::vector<std::uint32_t> start, edges; // edges put on each node of segment tree (in CSR format)
+	rollback_disjoint_set uf;
+	std::vector<bool> answer;
+	std::uint64_t key(std::size_t u, std::size_t v) const {
+		if (u > v) std::swap(u, v);
+		return std::uint64_t(u) * n + v;
+	}
+	void dfs(std::size_t node) {
+		std::size_t snapshot_id = uf.snapshot();
+		for (std::size_t i = start[node]; i < start[node + 1]; ++i) uf.link(ea[edges[i]], eb[edges[i]]);
+		if (node >= sz) {
+			if (node - sz < qa.size()) answer[node - sz] = uf.connected(qa[node - sz], qb[node - sz]);
+		}
+		else {
+			dfs(node * 2);
+			dfs(node * 2 + 1);
+		}
+		uf.rollback(snapshot_id);
+	}
+public:
+	explicit offline_dynamic_connectivity() : n(0), sz(0) {};
+	explicit offline_dynamic_connectivity(std::size_t n_) : n(n_), sz(0) {};
+	void add_edge(std::size_t u, std::size_t v) {
+		assert(u < n && v < n);
+		alive[key(u, v)].push_back(std::uint32_t(ea.size()));
+		ea.push_back(std::uint32_t(u));
+		eb.push_back(std::uint32_t(v));
+		el.push_back(std::uint32_t(qa.size()));
+		er.push_back(std::uint32_t(-1));
+	}
+	void remove_edge(std::size_t u, std::size_t v) {
+		// the edge (u, v) must be added before; with parallel edges, the latest one is removed
+		std::unordered_map<std::uint64_t, std::vector<std::uint32_t> >::iterator it = alive.find(key(u, v));
+		assert(it != alive.end() && !it->second.empty());
+		er[it->second.back()] = std::uint32_t(qa.size());
+		it->second.pop_back();
+		if (it->second.empty()) alive.erase(it);
+	}
+	std::size_t connected(std::size_t u, std::size_t v) {
+		// registers a query, and returns its index in the result of solve()
+		assert(u < n && v < n);
+		qa.push_back(std::uint32_t(u));
+		qb.push_back(std::uint32_t(v));
+		return qa.size() - 1;
+	}
+	std::vector<bool> solve() {
+		std::size_t q = qa.size();
+		sz = 1; while (sz < q) sz *= 2;
+		start = std::vector<std::uint32_t>(2 * sz + 1);
+		edges = std::vector<std::uint32_t>();
+		for (int step = 0; step < 2; ++step) {
+			// step 0: count edges on each node, step 1: fill them
+			for (std::size_t i = 0; i < ea.size(); ++i) {
+				std::size_t l = el[i] + sz, r = std::min<std::size_t>(er[i], q) + sz;
+				while (l < r) {
+					if (l & 1) { if (step == 0) ++start[l]; else edges[--start[l]] = std::uint32_t(i); ++l; }
+					if (r & 1) { --r; if (step == 0) ++start[r]; else edges[--start[r]] = std::uint32_t(i); }
+					l >>= 1; r >>= 1;
+				}
+			}
+			if (step == 0) {
+				for (std::size_t i = 1; i <= 2 * sz; ++i) start[i] += start[i - 1];
+				edges.resize(start[2 * sz]);
+			}
+		}
+		uf = rollback_disjoint_set(n);
+		answer = std::vector<bool>(q);
+		if (q != 0) dfs(1);
+		return answer;
+	}
+};
+
+#endif // CLASS_DYNAMIC_CONNECTIVITY
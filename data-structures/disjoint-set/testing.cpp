@@ -1,5 +1,6 @@
 #include <cmath>
 #include <chrono>
+#include <thread>
 #include <vector>
 #include <iostream>
 #include "disjoint-set.h"
@@ -43,11 +44,118 @@ void test(int n, int q) {
 	cout << fixed << "Initialization: " << (tsum1 / samples) / n << " seconds per element" << endl;
 	cout << fixed << "Linkings: " << (tsum2 / samples) / q << " seconds per query" << endl;
 }
+template <class disjoint_set_type>
+void test_width(const char* name, int n, int q) {
+	const int samples = 5;
+	double tsum = 0.0;
+	long long gsum = 0;
+	for(int t = 0; t < samples; ++t) {
+		disjoint_set_type uf(n);
+		chrono::system_clock::time_point start = chrono::system_clock::now();
+		for(int i = 0; i < q; ++i) {
+			int a = xorshift32() % n, b = xorshift32() % n;
+			uf.link(a, b);
+		}
+		long long sum = 0;
+		for(int i = 0; i < n; ++i) {
+			sum += uf.connected(i, i / 2);
+		}
+		chrono::system_clock::time_point finish = chrono::system_clock::now();
+		std::chrono::duration<double> linking_duration = finish - start;
+		tsum += linking_duration.count();
+		gsum += sum;
+	}
+	cout << fixed << name << ": " << (tsum / samples) / q << " seconds per query (" << n * sizeof(typename disjoint_set_type::value_type) << " bytes, Debug Answer: " << gsum << ")" << endl;
+}
+void test_widths(int n, int q) {
+	cout << "---------- WIDTH TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	if(n <= (1 << 15)) test_width<basic_disjoint_set<int16_t> >("basic_disjoint_set<int16_t>", n, q);
+	test_width<basic_disjoint_set<int32_t> >("basic_disjoint_set<int32_t>", n, q);
+	test_width<basic_disjoint_set<int64_t> >("basic_disjoint_set<int64_t>", n, q);
+	if(n <= (1 << 16) - 64) test_width<packed_disjoint_set<uint16_t> >("packed_disjoint_set<uint16_t>", n, q);
+	test_width<packed_disjoint_set<uint32_t> >("packed_disjoint_set<uint32_t>", n, q);
+}
+void test_concurrent(int n, int q) {
+	vector<int> ea(q), eb(q);
+	for(int i = 0; i < q; ++i) {
+		ea[i] = xorshift32() % n;
+		eb[i] = xorshift32() % n;
+	}
+	int max_threads = max(1, int(thread::hardware_concurrency()));
+	cout << "---------- CONCURRENT TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	vector<int> thread_counts;
+	for(int threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+	thread_counts.push_back(max_threads);
+	double tbase = 0.0;
+	for(int threads : thread_counts) {
+		concurrent_disjoint_set uf(n);
+		chrono::system_clock::time_point start = chrono::system_clock::now();
+		vector<thread> workers;
+		for(int t = 0; t < threads; ++t) {
+			workers.push_back(thread([&, t]() {
+				for(int i = 1LL * q * t / threads; i < 1LL * q * (t + 1) / threads; ++i) {
+					uf.link(ea[i], eb[i]);
+				}
+			}));
+		}
+		for(int t = 0; t < threads; ++t) workers[t].join();
+		chrono::system_clock::time_point finish = chrono::system_clock::now();
+		long long sum = 0;
+		for(int i = 0; i < n; ++i) {
+			sum += uf.connected(i, ea[i % q]);
+		}
+		std::chrono::duration<double> linking_duration = finish - start;
+		double tlink = linking_duration.count();
+		if(threads == 1) tbase = tlink;
+		cout << fixed << threads << " Threads: " << tlink / q << " seconds per query (" << q / tlink << " queries per second, x" << tbase / tlink << " speedup, Debug Answer: " << sum << ")" << endl;
+	}
+}
+void test_components(int n, int q) {
+	vector<pair<int, int> > edges(q);
+	for(int i = 0; i < q; ++i) {
+		edges[i].first = xorshift32() % n;
+		edges[i].second = xorshift32() % n;
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	disjoint_set uf(n);
+	for(int i = 0; i < q; ++i) {
+		uf.link(edges[i].first, edges[i].second);
+	}
+	long long sum1 = 0;
+	for(int i = 0; i < n; ++i) {
+		sum1 += uf.root(i);
+	}
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	vector<uint32_t> label = connected_components(n, edges.begin(), edges.end());
+	long long sum2 = 0;
+	for(int i = 0; i < n; ++i) {
+		sum2 += label[i];
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	std::chrono::duration<double> loop_duration = mid - start;
+	std::chrono::duration<double> bulk_duration = finish - mid;
+	cout << "---------- COMPONENTS TEST RESUTLTS (# of Elements = " << n << ", # of Edges = " << q << ") ----------" << endl;
+	cout << "Debug Answer: " << sum1 << ' ' << sum2 << endl;
+	cout << fixed << "link() + root() Loop: " << loop_duration.count() << " seconds (" << loop_duration.count() / q << " seconds per edge)" << endl;
+	cout << fixed << "connected_components(): " << bulk_duration.count() << " seconds (" << bulk_duration.count() / q << " seconds per edge)" << endl;
+}
 int main() {
 	for(int i = 12 * 3; i <= 26 * 3; ++i) {
 		double t = std::pow(2.0, i / 3.0);
 		int n = int(t);
 		test(n, n);
 	}
+	for(int i = 12 * 3; i <= 26 * 3; ++i) {
+		double t = std::pow(2.0, i / 3.0);
+		int n = int(t);
+		test_widths(n, n);
+	}
+	for(int i = 12; i <= 26; i += 2) {
+		test_concurrent(1 << i, 1 << i);
+	}
+	for(int i = 12; i <= 26; i += 2) {
+		test_components(1 << i, 1 << i);
+		test_components(1 << i, 1 << (i + 2));
+	}
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include "fenwick-tree.h"
+#include "concurrent-fenwick-tree.h"
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+template <class Worker>
+double run(int threads, Worker worker) {
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	vector<thread> workers;
+	for(int t = 0; t < threads; ++t) {
+		workers.push_back(thread(worker, t));
+	}
+	for(int t = 0; t < threads; ++t) workers[t].join();
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	std::chrono::duration<double> duration = finish - start;
+	return duration.count();
+}
+void test(int n, int q) {
+	// q addings are split among the writers; the histogram is skewed so that some positions are hot
+	vector<int> positions(q);
+	vector<long long> deltas(q);
+	for(int i = 0; i < q; ++i) {
+		unsigned r = xorshift32();
+		positions[i] = (r & 1 ? xorshift32() % 64 : xorshift32() % n);
+		deltas[i] = xorshift32() % 16 + 1;
+	}
+	int max_threads = max(1, int(thread::hardware_concurrency()));
+	vector<int> thread_counts;
+	for(int threads = 1; threads < max_threads; threads *= 2) thread_counts.push_back(threads);
+	thread_counts.push_back(max_threads);
+	cout.precision(12);
+	cout << "---------- CONCURRENT TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	double tbase[3] = { 0.0, 0.0, 0.0 };
+	for(int threads : thread_counts) {
+		fenwick_tree<long long> locked(n);
+		mutex mtx;
+		double tlocked = run(threads, [&](int t) {
+			for(int i = 1LL * q * t / threads; i < 1LL * q * (t + 1) / threads; ++i) {
+				lock_guard<mutex> lock(mtx);
+				locked.add(positions[i], deltas[i]);
+			}
+		});
+		concurrent_fenwick_tree<long long> atomic_fen(n);
+		double tatomic = run(threads, [&](int t) {
+			for(int i = 1LL * q * t / threads; i < 1LL * q * (t + 1) / threads; ++i) {
+				atomic_fen.add(positions[i], deltas[i]);
+			}
+		});
+		concurrent_fenwick_tree<long long> sharded_fen(n);
+		double tsharded = run(threads, [&](int t) {
+			concurrent_fenwick_tree<long long>::shard local(sharded_fen);
+			for(int i = 1LL * q * t / threads; i < 1LL * q * (t + 1) / threads; ++i) {
+				local.add(positions[i], deltas[i]);
+			}
+		});
+		long long sum = 0;
+		for(int i = 0; i < 1024; ++i) {
+			int r = xorshift32() % (n + 1);
+			long long expected = locked.getsum(r);
+			if(atomic_fen.getsum(r) != expected || sharded_fen.getsum(r) != expected) {
+				cout << "Wrong Answer" << endl;
+			}
+			sum += expected;
+		}
+		if(threads == 1) tbase[0] = tlocked, tbase[1] = tatomic, tbase[2] = tsharded;
+		cout << "Debug Answer: " << sum << endl;
+		cout << fixed << threads << " Threads (mutex): " << tlocked / q << " seconds per query (x" << tbase[0] / tlocked << " speedup)" << endl;
+		cout << fixed << threads << " Threads (atomic): " << tatomic / q << " seconds per query (x" << tbase[1] / tatomic << " speedup)" << endl;
+		cout << fixed << threads << " Threads (sharded): " << tsharded / q << " seconds per query (x" << tbase[2] / tsharded << " speedup)" << endl;
+	}
+	// readers running while the writers add: prefix sums only grow since all deltas are positive
+	concurrent_fenwick_tree<long long> fen(n);
+	int writers = max(1, max_threads / 2);
+	atomic<bool> done(false);
+	long long reads = 0, violations = 0;
+	thread reader([&]() {
+		long long last = 0;
+		while(!done.load()) {
+			long long cur = fen.getsum(n);
+			if(cur < last) ++violations;
+			last = cur;
+			++reads;
+		}
+	});
+	double tmixed = run(writers, [&](int t) {
+		for(int i = 1LL * q * t / writers; i < 1LL * q * (t + 1) / writers; ++i) {
+			fen.add(positions[i], deltas[i]);
+		}
+	});
+	done.store(true);
+	reader.join();
+	cout << fixed << writers << " Writers + 1 Reader: " << tmixed / q << " seconds per query (" << reads << " reads, " << violations << " decreasing)" << endl;
+}
+int main() {
+	for(int i = 12; i <= 24; i += 4) {
+		test(1 << i, 1 << 22);
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef CLASS_CONCURRENT_FENWICKTREE
+#define CLASS_CONCURRENT_FENWICKTREE
+
+#include <atomic>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+template <class type>
+class concurrent_fenwick_tree {
+	// Fenwick tree whose add(), getsum() and binary_search() may be called from any number of threads at the same time
+	// add() is a relaxed fetch_add on each node of the path; every position below r is in exactly one node of the path of getsum(r),
+	// so getsum(r) counts each add() running at the same time either entirely or not at all, and is exact once the writers are joined
+	static_assert(std::is_integral<type>::value, "fetch_add needs an integral type");
+private:
+	std::size_t n, sz;
+	std::vector<std::atomic<type> > val;
+public:
+	class shard {
+		// per-thread buffer: the nodes with large lowbit (near the root) are hit by most of add(), so their deltas are kept here and
+		// merged into the tree by flush(); until then, getsum() may miss a part of the buffered add()
+	private:
+		concurrent_fenwick_tree* tree;
+		std::size_t shift;
+		std::vector<type> pending; // pending[i >> shift] is the delta of the node i
+		std::vector<char> marked;
+		std::vector<std::size_t> dirty; // nodes with marked[i >> shift], which flush() visits
+		shard(const shard&);
+		shard& operator=(const shard&);
+	public:
+		explicit shard(concurrent_fenwick_tree& tree_, std::size_t max_buffer = 4096) : tree(&tree_), shift(0) {
+			while ((tree->sz >> shift) > max_buffer) ++shift;
+			pending = std::vector<type>((tree->sz >> shift) + 1, type(0));
+			marked = std::vector<char>((tree->sz >> shift) + 1, 0);
+		}
+		~shard() { flush(); }
+		void add(std::size_t pos, type delta) {
+			assert(0 <= pos && pos < tree->n);
+			std::size_t i = pos + 1;
+			for (; (i & ~(i - 1)) >> shift == 0; i += i & ~(i - 1)) {
+				tree->val[i].fetch_add(delta, std::memory_order_relaxed);
+			}
+			for (; i <= tree->sz; i += i & ~(i - 1)) {
+				if (!marked[i >> shift]) marked[i >> shift] = 1, dirty.push_back(i);
+				pending[i >> shift] += delta;
+			}
+		}
+		void flush() {
+			for (std::size_t j = 0; j < dirty.size(); ++j) {
+				std::size_t i = dirty[j];
+				if (pending[i >> shift] != type(0)) tree->val[i].fetch_add(pending[i >> shift], std::memory_order_relaxed);
+				pending[i >> shift] = type(0);
+				marked[i >> shift] = 0;
+			}
+			dirty.clear();
+		}
+	};
+	concurrent_fenwick_tree() : n(0), sz(0) {};
+	concurrent_fenwick_tree(std::size_t n_) : n(n_) {
+		sz = 1; while (sz < n) sz *= 2;
+		val = std::vector<std::atomic<type> >(sz + 1);
+		for (std::size_t i = 0; i <= sz; ++i) val[i].store(type(0), std::memory_order_relaxed);
+	}
+	std::size_t size() const { return n; }
+	void add(std::size_t pos, type delta) {
+		assert(0 <= pos && pos < n);
+		for (std::size_t i = pos + 1; i <= sz; i += i & ~(i - 1)) {
+			val[i].fetch_add(delta, std::memory_order_relaxed);
+		}
+	}
+	type getsum(std::size_t r) const {
+		assert(0 <= r && r <= n);
+		type ans = 0;
+		for (std::size_t i = r; i >= 1; i -= i & ~(i - 1)) {
+			ans += val[i].load(std::memory_order_relaxed);
+		}
+		return ans;
+	}
+	type getsum(std::size_t l, std::size_t r) const {
+		// the two prefixes are read one by one, so an add() running at the same time may be counted in only one of them
+		assert(0 <= l && l <= r && r <= n);
+		return getsum(r) - getsum(l);
+	}
+	std::size_t binary_search(type threshold) const {
+		std::size_t ans = 0;
+		for (std::size_t i = (sz >> 1); i >= 1; i >>= 1) {
+			type cur = val[ans + i].load(std::memory_order_relaxed);
+			if (threshold >= cur) {
+				threshold -= cur;
+				ans += i;
+			}
+		}
+		return ans;
+	}
+};
+
+#endif // CLASS_CONCURRENT_FENWICKTREE
\ No newline at end of file
@@ -25,13 +25,119 @@ void test(int n, int q) {
 		sum += fen.getsum(l, r);
 	}
 	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	vector<size_t> positions(q);
+	vector<long long> deltas(q);
+	vector<pair<size_t, size_t> > ranges(q);
+	for(int i = 0; i < q; ++i) {
+		positions[i] = xorshift32() % n;
+		deltas[i] = (long long)(xorshift32()) % 33 - 16;
+		int l = xorshift32() % n, r = xorshift32() % n;
+		if(l > r) std::swap(l, r);
+		ranges[i] = make_pair(l, r);
+	}
+	vector<long long> res;
+	chrono::system_clock::time_point batch_start = chrono::system_clock::now();
+	fen.add_batch(positions, deltas);
+	chrono::system_clock::time_point batch_mid = chrono::system_clock::now();
+	fen.getsum_batch(ranges, res);
+	chrono::system_clock::time_point batch_finish = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		sum += res[i];
+	}
 	cout.precision(12);
 	std::chrono::duration<double> adding_duration = mid - start;
 	std::chrono::duration<double> getsum_duration = finish - mid;
+	std::chrono::duration<double> batch_adding_duration = batch_mid - batch_start;
+	std::chrono::duration<double> batch_getsum_duration = batch_finish - batch_mid;
 	cout << "---------- TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
 	cout << "Answer: " << sum << endl;
 	cout << fixed << q << " Addings: " << adding_duration.count() << " seconds (" << adding_duration.count() / q << " seconds per query)" << endl;
 	cout << fixed << q << " Sum Getting: " << getsum_duration.count() << " seconds (" << getsum_duration.count() / q << " seconds per element)" << endl;
+	cout << fixed << q << " Batched Addings: " << batch_adding_duration.count() << " seconds (" << batch_adding_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Batched Sum Getting: " << batch_getsum_duration.count() << " seconds (" << batch_getsum_duration.count() / q << " seconds per query)" << endl;
+}
+void test_range(int n, int q) {
+	vector<long long> init(n);
+	for(int i = 0; i < n; ++i) {
+		init[i] = xorshift32() % 1024;
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	range_fenwick_tree<long long> fen(init.begin(), init.end());
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		int l = xorshift32() % n, r = xorshift32() % n;
+		if(l > r) std::swap(l, r);
+		fen.add(l, r + 1, (long long)(xorshift32()) % 33 - 16);
+	}
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		int l = xorshift32() % n, r = xorshift32() % n;
+		if(l > r) std::swap(l, r);
+		sum += fen.getsum(l, r + 1);
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> build_duration = mid - start;
+	std::chrono::duration<double> adding_duration = mid2 - mid;
+	std::chrono::duration<double> getsum_duration = finish - mid2;
+	cout << "---------- RANGE TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << endl;
+	cout << fixed << "Building: " << build_duration.count() << " seconds (" << build_duration.count() / n << " seconds per element)" << endl;
+	cout << fixed << q << " Range Addings: " << adding_duration.count() << " seconds (" << adding_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Range Sum Getting: " << getsum_duration.count() << " seconds (" << getsum_duration.count() / q << " seconds per query)" << endl;
+}
+void test_2d(int h, int w, int q) {
+	// fenwick_tree_2d against a vector of fenwick_tree (one per row of the tree)
+	vector<long long> init(1LL * h * w);
+	for(int i = 0; i < h * w; ++i) {
+		init[i] = xorshift32() % 1024;
+	}
+	vector<int> qr1(q), qc1(q), qr2(q), qc2(q), ar(q), ac(q);
+	for(int i = 0; i < q; ++i) {
+		qr1[i] = xorshift32() % (h + 1); qr2[i] = xorshift32() % (h + 1);
+		qc1[i] = xorshift32() % (w + 1); qc2[i] = xorshift32() % (w + 1);
+		if(qr1[i] > qr2[i]) std::swap(qr1[i], qr2[i]);
+		if(qc1[i] > qc2[i]) std::swap(qc1[i], qc2[i]);
+		ar[i] = xorshift32() % h; ac[i] = xorshift32() % w;
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	fenwick_tree_2d<long long> flat(h, w, init.begin(), init.end());
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		flat.add(ar[i], ac[i], 1);
+		sum += flat.getsum(qr1[i], qc1[i], qr2[i], qc2[i]);
+	}
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	vector<fenwick_tree<long long> > rows(h + 1);
+	for(int i = 1; i <= h; ++i) {
+		rows[i] = fenwick_tree<long long>(w);
+	}
+	for(int i = 0; i < h; ++i) {
+		for(int j = 0; j < w; ++j) {
+			for(int k = i + 1; k <= h; k += k & -k) rows[k].add(j, init[1LL * i * w + j]);
+		}
+	}
+	chrono::system_clock::time_point mid3 = chrono::system_clock::now();
+	long long sum2 = 0;
+	for(int i = 0; i < q; ++i) {
+		for(int k = ar[i] + 1; k <= h; k += k & -k) rows[k].add(ac[i], 1);
+		for(int k = qr2[i]; k >= 1; k -= k & -k) sum2 += rows[k].getsum(qc1[i], qc2[i]);
+		for(int k = qr1[i]; k >= 1; k -= k & -k) sum2 -= rows[k].getsum(qc1[i], qc2[i]);
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> flat_build_duration = mid - start;
+	std::chrono::duration<double> flat_duration = mid2 - mid;
+	std::chrono::duration<double> rows_build_duration = mid3 - mid2;
+	std::chrono::duration<double> rows_duration = finish - mid3;
+	cout << "---------- 2D TEST RESUTLTS (# of Elements = " << h << " * " << w << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << ' ' << sum2 << endl;
+	cout << fixed << "Building (flat): " << flat_build_duration.count() << " seconds" << endl;
+	cout << fixed << "Building (vector of fenwick_tree): " << rows_build_duration.count() << " seconds" << endl;
+	cout << fixed << q << " Addings + Rectangle Sums (flat): " << flat_duration.count() << " seconds (" << flat_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Addings + Rectangle Sums (vector of fenwick_tree): " << rows_duration.count() << " seconds (" << rows_duration.count() / q << " seconds per query)" << endl;
 }
 int main() {
 	test(1 << 18, 1 << 18);
@@ -44,5 +150,11 @@ int main() {
 	test(1 << 25, 1 << 25);
 	test(1 << 26, 1 << 26);
 	test(1 << 27, 1 << 27);
+	for(int i = 18; i <= 26; i += 2) {
+		test_range(1 << i, 1 << i);
+	}
+	for(int i = 8; i <= 13; ++i) {
+		test_2d(1 << i, 1 << i, 1 << 20);
+	}
 	return 0;
 }
\ No newline at end of file
@@ -4,12 +4,24 @@
 #include <vector>
 #include <cassert>
 #include <cstddef>
+#include <utility>
+
+struct tree_image_access;
 
 template <class type>
 class fenwick_tree {
 private:
 	std::size_t n, sz;
 	std::vector<type> val;
+	friend struct tree_image_access; // saving to a file (tree-image.h)
+	// batch operations prefetch the first (prefetch_depth) nodes of the query (prefetch_distance) ahead
+	// the later nodes of a path have large strides, and they are shared by many queries and usually in cache
+	static const std::size_t prefetch_distance = 8, prefetch_depth = 4;
+	static void prefetch(const type* ptr) {
+#if defined(__GNUC__)
+		__builtin_prefetch(ptr);
+#endif
+	}
 public:
 	fenwick_tree() : n(0), sz(0) {};
 	fenwick_tree(std::size_t n_) : n(n_) {
@@ -41,6 +53,29 @@ public:
 		assert(0 <= l && l <= r && r <= n);
 		return getsum(r) - getsum(l);
 	}
+	void add_batch(const std::vector<std::size_t>& positions, const std::vector<type>& deltas) {
+		// same as add() for each pair, but the paths of later updates are prefetched so that their cache misses overlap
+		assert(positions.size() == deltas.size());
+		for (std::size_t i = 0; i < positions.size(); ++i) {
+			if (i + prefetch_distance < positions.size()) {
+				std::size_t j = positions[i + prefetch_distance] + 1;
+				for (std::size_t d = 0; d < prefetch_depth && j <= sz; ++d, j += j & ~(j - 1)) prefetch(&val[j]);
+			}
+			add(positions[i], deltas[i]);
+		}
+	}
+	void getsum_batch(const std::vector<std::pair<std::size_t, std::size_t> >& ranges, std::vector<type>& out) const {
+		// out[i] = getsum(ranges[i].first, ranges[i].second), prefetching in the same way as add_batch()
+		out.resize(ranges.size());
+		for (std::size_t i = 0; i < ranges.size(); ++i) {
+			if (i + prefetch_distance < ranges.size()) {
+				std::size_t j = ranges[i + prefetch_distance].first, k = ranges[i + prefetch_distance].second;
+				for (std::size_t d = 0; d < prefetch_depth && j >= 1; ++d, j -= j & ~(j - 1)) prefetch(&val[j]);
+				for (std::size_t d = 0; d < prefetch_depth && k >= 1; ++d, k -= k & ~(k - 1)) prefetch(&val[k]);
+			}
+			out[i] = getsum(ranges[i].first, ranges[i].second);
+		}
+	}
 	std::size_t binary_search(type threshold) const {
 		std::size_t ans = 0;
 		for(std::size_t i = (sz >> 1); i >= 1; i >>= 1) {
@@ -53,4 +88,146 @@ public:
 	}
 };
 
+template <class type>
+class range_fenwick_tree {
+	// range add and range sum: with the prefix sums b1, b2 of two difference arrays, getsum(r) = b1(r) * r - b2(r)
+	// the two values of each node are stored together, so that each node of a path is one memory access
+private:
+	std::size_t n;
+	std::vector<std::pair<type, type> > val;
+	void add_raw(std::size_t pos, type delta) {
+		// adds delta to all elements in [pos, n)
+		type scaled = delta * type(pos);
+		for (std::size_t i = pos + 1; i <= n; i += i & ~(i - 1)) {
+			val[i].first += delta;
+			val[i].second += scaled;
+		}
+	}
+public:
+	range_fenwick_tree() : n(0), val(1) {};
+	range_fenwick_tree(std::size_t n_) : n(n_), val(n_ + 1) {}
+	template <class InputIterator>
+	range_fenwick_tree(InputIterator first, InputIterator last) : n(last - first), val(last - first + 1) {
+		// the differences of adjacent elements, and then the same O(n) build as fenwick_tree
+		type prev = type(0);
+		std::size_t cur = 0;
+		for (InputIterator it = first; it != last; ++it, ++cur) {
+			type diff = *it - prev;
+			val[cur + 1].first += diff;
+			val[cur + 1].second += diff * type(cur);
+			prev = *it;
+		}
+		for (std::size_t i = 1; i <= n; ++i) {
+			std::size_t j = i + (i & ~(i - 1));
+			if (j <= n) val[j].first += val[i].first, val[j].second += val[i].second;
+		}
+	}
+	void add(std::size_t l, std::size_t r, type delta) {
+		// adds delta to all elements in [l, r)
+		assert(0 <= l && l <= r && r <= n);
+		add_raw(l, delta);
+		add_raw(r, -delta);
+	}
+	void add(std::size_t pos, type delta) {
+		assert(0 <= pos && pos < n);
+		add(pos, pos + 1, delta);
+	}
+	type getsum(std::size_t r) const {
+		assert(0 <= r && r <= n);
+		type b1 = 0, b2 = 0;
+		for (std::size_t i = r; i >= 1; i -= i & ~(i - 1)) {
+			b1 += val[i].first;
+			b2 += val[i].second;
+		}
+		return b1 * type(r) - b2;
+	}
+	type getsum(std::size_t l, std::size_t r) const {
+		assert(0 <= l && l <= r && r <= n);
+		return getsum(r) - getsum(l);
+	}
+};
+
+template <class type>
+class fenwick_tree_2d {
+	// 2D Fenwick tree for point add and rectangle sum, in one row-major array of h * w elements
+	// a query walks the rows of the tree in the outer loop and the columns in the inner loop, so each row is accessed at once,
+	// and the path of the columns is computed only once for all of the rows
+private:
+	std::size_t h, w;
+	std::vector<type> val; // the node (i, j) (1-indexed) is val[(i - 1) * w + (j - 1)]
+	static const std::size_t max_path = 64;
+	std::size_t column_path(std::size_t c, std::size_t* cols) const {
+		std::size_t cnt = 0;
+		for (std::size_t j = c; j >= 1; j -= j & ~(j - 1)) cols[cnt++] = j - 1;
+		return cnt;
+	}
+public:
+	fenwick_tree_2d() : h(0), w(0) {};
+	fenwick_tree_2d(std::size_t h_, std::size_t w_) : h(h_), w(w_), val(h_ * w_) {}
+	template <class InputIterator>
+	fenwick_tree_2d(std::size_t h_, std::size_t w_, InputIterator first, InputIterator last) : h(h_), w(w_), val(first, last) {
+		// the elements in row-major order; the O(hw) build of fenwick_tree for each row, and then for the whole rows
+		assert(val.size() == h * w);
+		for (std::size_t i = 0; i < h; ++i) {
+			type* row = &val[i * w];
+			for (std::size_t j = 1; j <= w; ++j) {
+				std::size_t k = j + (j & ~(j - 1));
+				if (k <= w) row[k - 1] += row[j - 1];
+			}
+		}
+		for (std::size_t i = 1; i <= h; ++i) {
+			std::size_t k = i + (i & ~(i - 1));
+			if (k > h) continue;
+			type* dst = &val[(k - 1) * w];
+			const type* src = &val[(i - 1) * w];
+			for (std::size_t j = 0; j < w; ++j) dst[j] += src[j];
+		}
+	}
+	void add(std::size_t row, std::size_t col, type delta) {
+		assert(0 <= row && row < h && 0 <= col && col < w);
+		std::size_t cols[max_path];
+		std::size_t cnt = 0;
+		for (std::size_t j = col + 1; j <= w; j += j & ~(j - 1)) cols[cnt++] = j - 1;
+		for (std::size_t i = row + 1; i <= h; i += i & ~(i - 1)) {
+			type* cur = &val[(i - 1) * w];
+			for (std::size_t k = 0; k < cnt; ++k) cur[cols[k]] += delta;
+		}
+	}
+	type getsum(std::size_t r, std::size_t c) const {
+		// sum of the rectangle [0, r) * [0, c)
+		assert(0 <= r && r <= h && 0 <= c && c <= w);
+		std::size_t cols[max_path];
+		std::size_t cnt = column_path(c, cols);
+		type ans = 0;
+		for (std::size_t i = r; i >= 1; i -= i & ~(i - 1)) {
+			const type* cur = &val[(i - 1) * w];
+			for (std::size_t k = 0; k < cnt; ++k) ans += cur[cols[k]];
+		}
+		return ans;
+	}
+	type getsum(std::size_t r1, std::size_t c1, std::size_t r2, std::size_t c2) const {
+		// sum of the rectangle [r1, r2) * [c1, c2); the paths of r1 and r2 (and of c1 and c2) end in the same nodes, which cancel out,
+		// so only the nodes before they meet are visited, in the rows of r2 (+) and r1 (-) and the columns of c2 (+) and c1 (-)
+		assert(0 <= r1 && r1 <= r2 && r2 <= h && 0 <= c1 && c1 <= c2 && c2 <= w);
+		std::size_t cols_add[max_path], cols_sub[max_path];
+		std::size_t cnt_add = 0, cnt_sub = 0;
+		for (std::size_t j2 = c2, j1 = c1; j2 != j1; ) {
+			if (j2 > j1) cols_add[cnt_add++] = j2 - 1, j2 -= j2 & ~(j2 - 1);
+			else cols_sub[cnt_sub++] = j1 - 1, j1 -= j1 & ~(j1 - 1);
+		}
+		type ans = 0;
+		for (std::size_t i2 = r2, i1 = r1; i2 != i1; ) {
+			bool positive = (i2 > i1);
+			std::size_t i = (positive ? i2 : i1);
+			const type* cur = &val[(i - 1) * w];
+			type part = 0;
+			for (std::size_t k = 0; k < cnt_add; ++k) part += cur[cols_add[k]];
+			for (std::size_t k = 0; k < cnt_sub; ++k) part -= cur[cols_sub[k]];
+			if (positive) ans += part, i2 -= i2 & ~(i2 - 1);
+			else ans -= part, i1 -= i1 & ~(i1 - 1);
+		}
+		return ans;
+	}
+};
+
 #endif // CLASS_FENWICKTREE
\ No newline at end of file
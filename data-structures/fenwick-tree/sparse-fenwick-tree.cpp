@@ -0,0 +1,91 @@
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include "fenwick-tree.h"
+#include "sparse-fenwick-tree.h"
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+unsigned long long random_key() {
+	return ((unsigned long long)(xorshift32()) << 31) ^ xorshift32();
+}
+void test(int n, int q) {
+	// n random 63-bit keys; q addings to random keys, and q sums of random key ranges
+	vector<unsigned long long> keys(n);
+	for(int i = 0; i < n; ++i) {
+		keys[i] = random_key();
+	}
+	vector<unsigned long long> akey(q), ql(q), qr(q);
+	vector<long long> adelta(q);
+	for(int i = 0; i < q; ++i) {
+		akey[i] = keys[xorshift32() % n];
+		adelta[i] = xorshift32() % 16;
+		ql[i] = random_key(); qr[i] = random_key();
+		if(ql[i] > qr[i]) swap(ql[i], qr[i]);
+	}
+	cout.precision(12);
+	cout << "---------- TEST RESUTLTS (# of Keys = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	// sort and unique, then std::lower_bound and fenwick_tree
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	vector<unsigned long long> sorted(keys);
+	sort(sorted.begin(), sorted.end());
+	sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+	fenwick_tree<long long> fen(sorted.size());
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		fen.add(lower_bound(sorted.begin(), sorted.end(), akey[i]) - sorted.begin(), adelta[i]);
+	}
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		sum += fen.getsum(lower_bound(sorted.begin(), sorted.end(), ql[i]) - sorted.begin(), lower_bound(sorted.begin(), sorted.end(), qr[i]) - sorted.begin());
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	std::chrono::duration<double> d0 = mid - start, d1 = mid2 - mid, d2 = finish - mid2;
+	cout << "Answer (sorted + lower_bound): " << sum << endl;
+	cout << fixed << "Building: " << d0.count() << " seconds, " << q << " Addings: " << d1.count() / q << " seconds per query, " << q << " Sum Getting: " << d2.count() / q << " seconds per query" << endl;
+	// compressed_fenwick_tree
+	start = chrono::system_clock::now();
+	compressed_fenwick_tree<long long> cfen(keys.begin(), keys.end());
+	mid = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		cfen.add(akey[i], adelta[i]);
+	}
+	mid2 = chrono::system_clock::now();
+	sum = 0;
+	for(int i = 0; i < q; ++i) {
+		sum += cfen.getsum(ql[i], qr[i]);
+	}
+	finish = chrono::system_clock::now();
+	d0 = mid - start, d1 = mid2 - mid, d2 = finish - mid2;
+	cout << "Answer (compressed_fenwick_tree): " << sum << ' ' << cfen.binary_search(cfen.getsum(ql[0], qr[0])) << endl;
+	cout << fixed << "Building: " << d0.count() << " seconds, " << q << " Addings: " << d1.count() / q << " seconds per query, " << q << " Sum Getting: " << d2.count() / q << " seconds per query" << endl;
+	// hashed_fenwick_tree
+	start = chrono::system_clock::now();
+	hashed_fenwick_tree<long long> hfen(63);
+	mid = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		hfen.add(akey[i], adelta[i]);
+	}
+	mid2 = chrono::system_clock::now();
+	sum = 0;
+	for(int i = 0; i < q; ++i) {
+		sum += hfen.getsum(ql[i], qr[i]);
+	}
+	finish = chrono::system_clock::now();
+	d0 = mid - start, d1 = mid2 - mid, d2 = finish - mid2;
+	cout << "Answer (hashed_fenwick_tree): " << sum << ' ' << hfen.binary_search(hfen.getsum(ql[0], qr[0])) << " (" << hfen.node_count() << " nodes)" << endl;
+	cout << fixed << "Building: " << d0.count() << " seconds, " << q << " Addings: " << d1.count() / q << " seconds per query, " << q << " Sum Getting: " << d2.count() / q << " seconds per query" << endl;
+}
+int main() {
+	for(int i = 16; i <= 24; i += 4) {
+		test(1 << i, 1 << 20);
+	}
+	return 0;
+}
\ No newline at end of file
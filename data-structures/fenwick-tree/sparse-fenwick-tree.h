@@ -0,0 +1,207 @@
+#ifndef CLASS_SPARSE_FENWICKTREE
+#define CLASS_SPARSE_FENWICKTREE
+
+#include <vector>
+#include <limits>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+template <class type>
+class compressed_fenwick_tree {
+	// Fenwick tree over a fixed set of 64-bit keys, known in advance (offline); the keys are compressed into [0, m)
+	// A key is found by lower bound on the keys in Eytzinger layout (BFS order of a complete binary search tree),
+	// whose top levels stay in cache, and the next levels are prefetched while the current one is compared
+private:
+	std::size_t m;
+	std::vector<std::uint64_t> eyt; // eyt[1..m]: the keys in Eytzinger layout
+	std::vector<std::uint32_t> order; // order[k]: the index of eyt[k] in sorted order
+	std::vector<type> val; // val[1..m]: Fenwick tree over the sorted keys
+	static void prefetch(const std::uint64_t* ptr) {
+#if defined(__GNUC__)
+		__builtin_prefetch(ptr);
+#endif
+	}
+	std::size_t fill(const std::vector<std::uint64_t>& keys, std::size_t i, std::size_t k) {
+		// in-order traversal of the implicit tree puts the sorted keys
+		if (k <= m) {
+			i = fill(keys, i, 2 * k);
+			eyt[k] = keys[i];
+			order[k] = std::uint32_t(i++);
+			i = fill(keys, i, 2 * k + 1);
+		}
+		return i;
+	}
+public:
+	compressed_fenwick_tree() : m(0), eyt(1), order(1), val(1) {};
+	template <class InputIterator>
+	compressed_fenwick_tree(InputIterator first, InputIterator last) {
+		// the keys may have duplicates and may be in any order
+		std::vector<std::uint64_t> keys(first, last);
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+		m = keys.size();
+		assert(m < std::numeric_limits<std::uint32_t>::max());
+		eyt = std::vector<std::uint64_t>(m + 1);
+		order = std::vector<std::uint32_t>(m + 1);
+		val = std::vector<type>(m + 1);
+		fill(keys, 0, 1);
+	}
+	std::size_t size() const { return m; }
+	std::size_t lower_node(std::uint64_t key) const {
+		// the node of the lower bound of key in eyt (0 if all keys are less than key)
+		std::size_t k = 1;
+		while (k <= m) {
+			// 8 keys in a cache line: the descendants 3 levels below
+			if (8 * k <= m) prefetch(&eyt[8 * k]);
+			k = 2 * k + (eyt[k] < key);
+		}
+		// the last node where it went left
+		while (k & 1) k >>= 1;
+		return k >> 1;
+	}
+	std::size_t rank(std::uint64_t key) const {
+		// the number of keys less than key
+		std::size_t k = lower_node(key);
+		return k == 0 ? m : order[k];
+	}
+	void add(std::uint64_t key, type delta) {
+		std::size_t k = lower_node(key);
+		assert(k != 0 && eyt[k] == key); // key must be one of the keys given to the constructor
+		for (std::size_t i = order[k] + 1; i <= m; i += i & ~(i - 1)) {
+			val[i] += delta;
+		}
+	}
+	type getsum(std::uint64_t r) const {
+		// sum of the keys less than r
+		type ans = 0;
+		for (std::size_t i = rank(r); i >= 1; i -= i & ~(i - 1)) {
+			ans += val[i];
+		}
+		return ans;
+	}
+	type getsum(std::uint64_t l, std::uint64_t r) const {
+		assert(l <= r);
+		return getsum(r) - getsum(l);
+	}
+	std::uint64_t binary_search(type threshold) const {
+		// returns the largest r such that getsum(r) <= threshold (the key whose value makes the sum exceed), assuming non-negative values
+		// if the sum of all keys is at most threshold, it returns the maximum of 64-bit integers
+		std::size_t ans = 0, step = 1;
+		while (step * 2 <= m) step *= 2;
+		for (; step >= 1 && m != 0; step >>= 1) {
+			if (ans + step <= m && val[ans + step] <= threshold) {
+				threshold -= val[ans + step];
+				ans += step;
+			}
+		}
+		return ans == m ? std::numeric_limits<std::uint64_t>::max() : key_at(ans);
+	}
+	std::uint64_t key_at(std::size_t pos) const {
+		// the pos-th smallest key, following the path of the complete binary tree to the in-order index pos
+		assert(pos < m);
+		std::size_t k = 1;
+		while (true) {
+			std::size_t idx = order[k];
+			if (idx == pos) return eyt[k];
+			k = 2 * k + (idx < pos);
+		}
+	}
+};
+
+template <class type>
+class hashed_fenwick_tree {
+	// Fenwick tree over [0, 2^bits) whose keys are not known in advance (online); only the non-zero nodes are stored,
+	// in an open-addressing hash table with linear probing, so the memory is O(q bits) after q additions
+	// Each operation touches at most bits + 1 nodes, and a node which is not in the table is zero
+private:
+	std::size_t bits, lg;
+	std::vector<std::pair<std::uint64_t, type> > table; // (node index, value); node index 0 means an empty slot
+	std::size_t used;
+	std::size_t slot(std::uint64_t node) const {
+		return std::size_t((node * 0x9e3779b97f4a7c15ull) >> (64 - lg));
+	}
+	type find(std::uint64_t node) const {
+		std::size_t mask = table.size() - 1;
+		for (std::size_t i = slot(node); ; i = (i + 1) & mask) {
+			if (table[i].first == node) return table[i].second;
+			if (table[i].first == 0) return type(0);
+		}
+	}
+	void grow() {
+		std::vector<std::pair<std::uint64_t, type> > old;
+		old.swap(table);
+		++lg;
+		table = std::vector<std::pair<std::uint64_t, type> >(std::size_t(1) << lg, std::make_pair(std::uint64_t(0), type(0)));
+		std::size_t mask = table.size() - 1;
+		for (std::size_t j = 0; j < old.size(); ++j) {
+			if (old[j].first == 0) continue;
+			std::size_t i = slot(old[j].first);
+			while (table[i].first != 0) i = (i + 1) & mask;
+			table[i] = old[j];
+		}
+	}
+	void add_node(std::uint64_t node, type delta) {
+		std::size_t mask = table.size() - 1;
+		std::size_t i = slot(node);
+		while (table[i].first != 0 && table[i].first != node) i = (i + 1) & mask;
+		if (table[i].first == 0) {
+			// load factor at most 1/2
+			if (2 * (used + 1) > table.size()) {
+				grow();
+				add_node(node, delta);
+				return;
+			}
+			table[i].first = node;
+			++used;
+		}
+		table[i].second += delta;
+	}
+public:
+	hashed_fenwick_tree(std::size_t bits_ = 63) : bits(bits_), lg(4), used(0) {
+		assert(1 <= bits && bits <= 63);
+		table = std::vector<std::pair<std::uint64_t, type> >(std::size_t(1) << lg, std::make_pair(std::uint64_t(0), type(0)));
+	}
+	void reserve(std::size_t nodes) {
+		while ((std::size_t(1) << lg) < 2 * nodes) grow();
+	}
+	std::size_t node_count() const { return used; }
+	void add(std::uint64_t key, type delta) {
+		assert(key < (std::uint64_t(1) << bits));
+		std::uint64_t limit = std::uint64_t(1) << bits;
+		for (std::uint64_t i = key + 1; i <= limit; i += i & ~(i - 1)) {
+			add_node(i, delta);
+			if (i == limit) break; // i + lowbit(i) overflows when bits = 63
+		}
+	}
+	type getsum(std::uint64_t r) const {
+		// sum of the keys less than r
+		assert(r <= (std::uint64_t(1) << bits));
+		type ans = 0;
+		for (std::uint64_t i = r; i >= 1; i -= i & ~(i - 1)) {
+			ans += find(i);
+		}
+		return ans;
+	}
+	type getsum(std::uint64_t l, std::uint64_t r) const {
+		assert(l <= r);
+		return getsum(r) - getsum(l);
+	}
+	std::uint64_t binary_search(type threshold) const {
+		// returns the largest r such that getsum(r) <= threshold, assuming non-negative values
+		std::uint64_t ans = 0;
+		for (std::uint64_t step = std::uint64_t(1) << bits; step >= 1; step >>= 1) {
+			if (ans + step > (std::uint64_t(1) << bits)) continue;
+			type cur = find(ans + step);
+			if (cur <= threshold) {
+				threshold -= cur;
+				ans += step;
+			}
+		}
+		return ans;
+	}
+};
+
+#endif // CLASS_SPARSE_FENWICKTREE
\ No newline at end of file
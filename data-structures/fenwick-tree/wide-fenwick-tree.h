@@ -0,0 +1,88 @@
+#ifndef CLASS_WIDE_FENWICKTREE
+#define CLASS_WIDE_FENWICKTREE
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include "../cache-aligned-allocator.h"
+
+template <class type>
+class wide_fenwick_tree {
+	// Prefix sums with B-ary levels of cache lines (B = 64 / sizeof(type)); no rounding to a power of two, and about n * B / (B - 1) elements
+	// Level 0 is the array itself, and the element j of level k + 1 is the sum of block j (B elements) of level k
+	// Each block keeps prefix sums inside it, so getsum() reads one element per level and binary_search() scans one cache line per level
+	// add() rewrites a suffix of one cache line per level, over only log_B(n) levels
+public:
+	static const std::size_t B = 64 / sizeof(type);
+private:
+	static_assert(sizeof(type) <= 32 && 64 % sizeof(type) == 0, "type must fit in a cache line at least twice");
+	std::size_t n;
+	std::vector<type, cache_aligned_allocator<type> > val;
+	std::vector<std::size_t> offset; // level k is val[offset[k], offset[k + 1])
+	void init() {
+		std::size_t len = (n + B - 1) / B * B;
+		if (len == 0) len = B;
+		offset = std::vector<std::size_t>(1, 0);
+		while (true) {
+			offset.push_back(offset.back() + len);
+			if (len == B) break;
+			len = (len / B + B - 1) / B * B;
+		}
+		val = std::vector<type, cache_aligned_allocator<type> >(offset.back(), type(0));
+	}
+public:
+	wide_fenwick_tree() : n(0) { init(); };
+	wide_fenwick_tree(std::size_t n_) : n(n_) { init(); }
+	template <class InputIterator>
+	wide_fenwick_tree(InputIterator first, InputIterator last) : n(last - first) {
+		init();
+		std::size_t cur = 0;
+		for (InputIterator it = first; it != last; ++it) val[cur++] = *it;
+		for (std::size_t k = 0; k + 2 < offset.size(); ++k) {
+			for (std::size_t i = offset[k]; i < offset[k + 1]; ++i) val[offset[k + 1] + (i - offset[k]) / B] += val[i];
+		}
+		for (std::size_t i = 0; i < offset.back(); ++i) {
+			if (i % B != 0) val[i] += val[i - 1];
+		}
+	}
+	void add(std::size_t pos, type delta) {
+		assert(0 <= pos && pos < n);
+		for (std::size_t k = 0; k + 1 < offset.size(); ++k) {
+			// the suffix of the block from pos, with a mask so that the loop has a fixed trip count and is vectorized
+			type* cur = &val[offset[k] + pos / B * B];
+			std::size_t from = pos % B;
+			for (std::size_t i = 0; i < B; ++i) cur[i] += (i >= from ? delta : type(0));
+			pos /= B;
+		}
+	}
+	type getsum(std::size_t r) const {
+		assert(0 <= r && r <= n);
+		type ans = 0;
+		for (std::size_t k = 0; r != 0; ++k) {
+			if (k + 2 == offset.size()) return ans + val[offset[k] + r - 1]; // the top level is only one block
+			if (r % B != 0) ans += val[offset[k] + r - 1];
+			r /= B;
+		}
+		return ans;
+	}
+	type getsum(std::size_t l, std::size_t r) const {
+		assert(0 <= l && l <= r && r <= n);
+		return getsum(r) - getsum(l);
+	}
+	std::size_t binary_search(type threshold) const {
+		// returns the largest r such that getsum(r) <= threshold, assuming all elements are non-negative
+		std::size_t ans = 0;
+		for (std::size_t k = offset.size() - 1; k-- > 0; ) {
+			const type* cur = &val[offset[k] + ans * B];
+			// the block holds prefix sums, so the number of them at most threshold is the next digit (counted without branches)
+			std::size_t cnt = 0;
+			for (std::size_t i = 0; i < B; ++i) cnt += (cur[i] <= threshold);
+			if (cnt == B) return n; // only at the top level: the total is at most threshold
+			if (cnt != 0) threshold -= cur[cnt - 1];
+			ans = ans * B + cnt;
+		}
+		return ans < n ? ans : n;
+	}
+};
+
+#endif // CLASS_WIDE_FENWICKTREE
\ No newline at end of file
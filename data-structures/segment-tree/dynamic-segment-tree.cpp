@@ -0,0 +1,47 @@
+#include "dynamic-segment-tree.h"
+#include <chrono>
+#include <iostream>
+using namespace std;
+unsigned long long x = 88172645463325252ULL;
+unsigned long long xorshift64() {
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	return x;
+}
+void test(unsigned long long n, int q) {
+	dynamic_segment_tree<long long, static_monoid_sum<long long> > seg(n);
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	seg.reserve(48ULL * q);
+	for(int i = 0; i < q; ++i) {
+		unsigned long long pos = xorshift64() % n; long long val = (long long)(xorshift64() % 33) - 16;
+		seg.update(pos, val);
+	}
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		unsigned long long l = xorshift64() % n, r = xorshift64() % n;
+		if(l > r) std::swap(l, r);
+		sum += seg.range_query(l, r + 1);
+	}
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	size_t nodes = seg.node_count();
+	seg.clear();
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> update_duration = mid - start;
+	std::chrono::duration<double> query_duration = mid2 - mid;
+	std::chrono::duration<double> clear_duration = finish - mid2;
+	cout << "---------- TEST RESUTLTS (Index Space = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << endl;
+	cout << "Nodes: " << nodes << " (" << double(nodes) / q << " nodes per update)" << endl;
+	cout << fixed << q << " Updates: " << update_duration.count() << " seconds (" << update_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Range Queries: " << query_duration.count() << " seconds (" << query_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << "Clear: " << clear_duration.count() << " seconds" << endl;
+}
+int main() {
+	for(int i = 12; i <= 20; ++i) {
+		test(1000000000000000000ULL, 1 << i);
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef CLASS_DYNAMIC_SEGMENT_TREE
+#define CLASS_DYNAMIC_SEGMENT_TREE
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include "segment-tree.h"
+
+template <class type, class Op = monoid<type> >
+class dynamic_segment_tree {
+	// Segment tree over [0, n) for huge n (up to 2^63) without coordinate compression; a node is created on the first update below it
+	// All nodes live in one contiguous pool with 32-bit child indices, so the memory is proportional to the number of touched paths
+	// Node 0 is the null node, which stands for a subtree of identities, and node 1 is the root
+private:
+	struct node {
+		type val;
+		std::uint32_t child[2];
+	};
+	std::uint64_t n, sz;
+	std::vector<node> pool;
+	Op M;
+	std::uint32_t new_node() {
+		node nd = { M.identity(), { 0, 0 } };
+		pool.push_back(nd);
+		assert(pool.size() - 1 <= std::uint32_t(-1));
+		return std::uint32_t(pool.size() - 1);
+	}
+	type query(std::uint32_t k, std::uint64_t lo, std::uint64_t hi, std::uint64_t l, std::uint64_t r) const {
+		// fold of [l, r) in the subtree of node k, which covers [lo, hi)
+		if (k == 0 || r <= lo || hi <= l) return M.identity();
+		if (l <= lo && hi <= r) return pool[k].val;
+		std::uint64_t mid = lo + (hi - lo) / 2;
+		return M(query(pool[k].child[0], lo, mid, l, r), query(pool[k].child[1], mid, hi, l, r));
+	}
+public:
+	explicit dynamic_segment_tree() : n(0), sz(1), M(Op()) { clear(); };
+	explicit dynamic_segment_tree(std::uint64_t n_, Op M_ = Op()) : n(n_), M(M_) {
+		assert(n <= (std::uint64_t(1) << 63));
+		sz = 1; while (sz < n) sz *= 2;
+		clear();
+	}
+	void reserve(std::size_t nodes) { pool.reserve(nodes + 2); }
+	void clear() {
+		// frees the whole tree at once; the capacity of the pool is kept
+		pool.clear();
+		new_node();
+		new_node();
+	}
+	std::size_t node_count() const { return pool.size() - 2; }
+	void update(std::uint64_t pos, type nxtval) {
+		assert(0 <= pos && pos < n);
+		std::uint32_t path[65];
+		std::size_t depth = 0;
+		std::uint32_t k = 1;
+		for (std::uint64_t w = sz; w > 1; w >>= 1) {
+			path[depth++] = k;
+			int dir = (pos & (w >> 1)) ? 1 : 0;
+			if (pool[k].child[dir] == 0) {
+				std::uint32_t c = new_node();
+				pool[k].child[dir] = c;
+			}
+			k = pool[k].child[dir];
+		}
+		pool[k].val = nxtval;
+		while (depth > 0) {
+			k = path[--depth];
+			pool[k].val = M(pool[pool[k].child[0]].val, pool[pool[k].child[1]].val);
+		}
+	}
+	type operator[](std::uint64_t idx) const {
+		assert(0 <= idx && idx < n);
+		std::uint32_t k = 1;
+		for (std::uint64_t w = sz; w > 1 && k != 0; w >>= 1) k = pool[k].child[(idx & (w >> 1)) ? 1 : 0];
+		return k != 0 ? pool[k].val : M.identity();
+	}
+	type range_query(std::uint64_t l, std::uint64_t r) const {
+		assert(0 <= l && l <= r && r <= n);
+		return query(1, 0, sz, l, r);
+	}
+};
+
+#endif // CLASS_DYNAMIC_SEGMENT_TREE
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "lazy-segment-tree.h"
+#include <chrono>
+#include <limits>
+#include <iostream>
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+struct add_to_min {
+	// range add for range minimum; the identity (no element) stays as it is
+	long long operator()(long long f, long long val) const { return val == numeric_limits<long long>::max() ? val : val + f; }
+};
+void test(int n, int q) {
+	lazy_segment_tree<long long, long long, static_monoid_min<long long>, static_monoid_sum<long long>, add_to_min> seg(n);
+	for(int i = 0; i < n; ++i) {
+		seg.update(i, xorshift32());
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		int l = xorshift32() % n, r = xorshift32() % n;
+		if(l > r) std::swap(l, r);
+		seg.apply(l, r + 1, (long long)(xorshift32() % 33) - 16);
+	}
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		int l = xorshift32() % n, r = xorshift32() % n;
+		if(l > r) std::swap(l, r);
+		sum += seg.prod(l, r + 1);
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> apply_duration = mid - start;
+	std::chrono::duration<double> prod_duration = finish - mid;
+	cout << "---------- TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << ' ' << seg.all_prod() << endl;
+	cout << fixed << q << " Range Adds: " << apply_duration.count() << " seconds (" << apply_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Range Queries: " << prod_duration.count() << " seconds (" << prod_duration.count() / q << " seconds per element)" << endl;
+}
+int main() {
+	test(1 << 18, 1 << 18);
+	test(1 << 19, 1 << 19);
+	test(1 << 20, 1 << 20);
+	test(1 << 21, 1 << 21);
+	test(1 << 22, 1 << 22);
+	test(1 << 23, 1 << 23);
+	test(1 << 24, 1 << 24);
+	test(1 << 25, 1 << 25);
+	test(1 << 26, 1 << 26);
+	test(1 << 27, 1 << 27);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef CLASS_LAZY_SEGMENT_TREE
+#define CLASS_LAZY_SEGMENT_TREE
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include "segment-tree.h"
+
+template <class type, class action, class Op = monoid<type>, class Act = monoid<action>, class Map = std::function<type(action, type)> >
+class lazy_segment_tree {
+	// Op: monoid of values, Act: monoid of actions where A(f, g) is the composition "apply g, then f", Map: F(f, x) applies action f to value x
+	// Each of them is either type-erased (monoid, std::function) or a stateless policy, in the same way as segment_tree
+private:
+	std::size_t n, sz, lg;
+	std::vector<type> val;
+	std::vector<action> lazy;
+	Op M;
+	Act A;
+	Map F;
+	void pull(std::size_t k) { val[k] = M(val[2 * k], val[2 * k + 1]); }
+	void apply_node(std::size_t k, const action& f) {
+		val[k] = F(f, val[k]);
+		if (k < sz) lazy[k] = A(f, lazy[k]);
+	}
+	void push(std::size_t k) {
+		apply_node(2 * k, lazy[k]);
+		apply_node(2 * k + 1, lazy[k]);
+		lazy[k] = A.identity();
+	}
+	void init() {
+		sz = 1; lg = 0;
+		while (sz < n) sz *= 2, ++lg;
+		val = std::vector<type>(2 * sz, M.identity());
+		lazy = std::vector<action>(sz, A.identity());
+	}
+public:
+	explicit lazy_segment_tree() : n(0), sz(0), lg(0), M(Op()), A(Act()), F(Map()) {};
+	explicit lazy_segment_tree(std::size_t n_, Op M_ = Op(), Act A_ = Act(), Map F_ = Map()) : n(n_), M(M_), A(A_), F(F_) {
+		init();
+	}
+	template <class InputIterator>
+	explicit lazy_segment_tree(Op M_, Act A_, Map F_, InputIterator first, InputIterator last) : n(last - first), M(M_), A(A_), F(F_) {
+		init();
+		std::size_t cur = sz;
+		for (InputIterator it = first; it != last; ++it) val[cur++] = *it;
+		for (std::size_t i = sz - 1; i >= 1; --i) pull(i);
+	}
+	void update(std::size_t pos, type nxtval) {
+		assert(0 <= pos && pos < n);
+		pos += sz;
+		for (std::size_t i = lg; i >= 1; --i) push(pos >> i);
+		val[pos] = nxtval;
+		for (std::size_t i = 1; i <= lg; ++i) pull(pos >> i);
+	}
+	type get(std::size_t pos) {
+		assert(0 <= pos && pos < n);
+		pos += sz;
+		for (std::size_t i = lg; i >= 1; --i) push(pos >> i);
+		return val[pos];
+	}
+	type prod(std::size_t l, std::size_t r) {
+		assert(0 <= l && l <= r && r <= n);
+		if (l == r) return M.identity();
+		l += sz; r += sz;
+		for (std::size_t i = lg; i >= 1; --i) {
+			if (((l >> i) << i) != l) push(l >> i);
+			if (((r >> i) << i) != r) push((r - 1) >> i);
+		}
+		type ansl = M.identity(), ansr = M.identity();
+		while (l != r) {
+			if (l & 1) ansl = M(ansl, val[l]), ++l;
+			if (r & 1) --r, ansr = M(val[r], ansr);
+			l >>= 1; r >>= 1;
+		}
+		return M(ansl, ansr);
+	}
+	type all_prod() const { return val[1]; }
+	void apply(std::size_t pos, action f) {
+		assert(0 <= pos && pos < n);
+		pos += sz;
+		for (std::size_t i = lg; i >= 1; --i) push(pos >> i);
+		val[pos] = F(f, val[pos]);
+		for (std::size_t i = 1; i <= lg; ++i) pull(pos >> i);
+	}
+	void apply(std::size_t l, std::size_t r, action f) {
+		assert(0 <= l && l <= r && r <= n);
+		if (l == r) return;
+		l += sz; r += sz;
+		for (std::size_t i = lg; i >= 1; --i) {
+			if (((l >> i) << i) != l) push(l >> i);
+			if (((r >> i) << i) != r) push((r - 1) >> i);
+		}
+		std::size_t l2 = l, r2 = r;
+		while (l != r) {
+			if (l & 1) apply_node(l++, f);
+			if (r & 1) apply_node(--r, f);
+			l >>= 1; r >>= 1;
+		}
+		l = l2; r = r2;
+		for (std::size_t i = 1; i <= lg; ++i) {
+			if (((l >> i) << i) != l) pull(l >> i);
+			if (((r >> i) << i) != r) pull((r - 1) >> i);
+		}
+	}
+};
+
+#endif // CLASS_LAZY_SEGMENT_TREE
\ No newline at end of file
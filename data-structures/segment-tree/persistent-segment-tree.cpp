@@ -0,0 +1,70 @@
+#include "persistent-segment-tree.h"
+#include <chrono>
+#include <vector>
+#include <iostream>
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+void test(int n, int q) {
+	vector<long long> init(n);
+	for(int i = 0; i < n; ++i) {
+		init[i] = xorshift32() % 33;
+	}
+	persistent_segment_tree<long long, static_monoid_sum<long long> > seg(static_monoid_sum<long long>(), init.begin(), init.end());
+	vector<persistent_segment_tree<long long, static_monoid_sum<long long> >::version> vers(1, seg.initial());
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		// each update is applied to a random older version
+		int pos = xorshift32() % n; long long val = xorshift32() % 33;
+		vers.push_back(seg.update(vers[xorshift32() % vers.size()], pos, val));
+	}
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		int l = xorshift32() % n, r = xorshift32() % n;
+		if(l > r) std::swap(l, r);
+		sum += seg.range_query(vers[xorshift32() % vers.size()], l, r + 1);
+	}
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	// k-th smallest in a range: version i has the first i values (taken in [0, n)) counted
+	persistent_segment_tree<int, static_monoid_sum<int> > cnt(n);
+	vector<persistent_segment_tree<int, static_monoid_sum<int> >::version> pre(1, cnt.initial());
+	for(int i = 0; i < n; ++i) {
+		int val = xorshift32() % n;
+		pre.push_back(cnt.update(pre.back(), val, cnt.get(pre.back(), val) + 1));
+	}
+	chrono::system_clock::time_point mid3 = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		int l = xorshift32() % n, r = xorshift32() % n;
+		if(l > r) std::swap(l, r);
+		sum += cnt.kth(pre[l], pre[r + 1], xorshift32() % (r - l + 1));
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> update_duration = mid - start;
+	std::chrono::duration<double> query_duration = mid2 - mid;
+	std::chrono::duration<double> build_duration = mid3 - mid2;
+	std::chrono::duration<double> kth_duration = finish - mid3;
+	cout << "---------- TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << endl;
+	cout << "Nodes: " << seg.node_count() << " (" << double(seg.node_count() - 2 * n) / q << " nodes per version)" << endl;
+	cout << fixed << q << " Updates: " << update_duration.count() << " seconds (" << update_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Range Queries: " << query_duration.count() << " seconds (" << query_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << n << " Counting Versions: " << build_duration.count() << " seconds (" << build_duration.count() / n << " seconds per element)" << endl;
+	cout << fixed << q << " K-th Smallest Queries: " << kth_duration.count() << " seconds (" << kth_duration.count() / q << " seconds per query)" << endl;
+}
+int main() {
+	test(1 << 16, 1 << 16);
+	test(1 << 17, 1 << 17);
+	test(1 << 18, 1 << 18);
+	test(1 << 19, 1 << 19);
+	test(1 << 20, 1 << 20);
+	test(1 << 21, 1 << 21);
+	test(1 << 22, 1 << 22);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef CLASS_PERSISTENT_SEGMENT_TREE
+#define CLASS_PERSISTENT_SEGMENT_TREE
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include "segment-tree.h"
+
+template <class type, class Op = monoid<type> >
+class persistent_segment_tree {
+	// Fully persistent segment tree: update() copies only the O(log n) nodes on the path, and returns the handle of the new version
+	// All versions share one pool of nodes with 32-bit child indices; node 0 is the null node, which stands for a subtree of identities
+public:
+	typedef std::uint32_t version;
+private:
+	struct node {
+		type val;
+		std::uint32_t child[2];
+	};
+	std::size_t n, sz;
+	std::vector<node> pool;
+	std::size_t base_nodes; // nodes of the null node and the initial version
+	version init_version;
+	Op M;
+	std::uint32_t clone(std::uint32_t k) {
+		pool.push_back(pool[k]);
+		assert(pool.size() - 1 <= std::uint32_t(-1));
+		return std::uint32_t(pool.size() - 1);
+	}
+	template <class InputIterator>
+	std::uint32_t build(std::size_t w, InputIterator& it, std::size_t& rest) {
+		// builds a subtree of width w from the next elements
+		if (rest == 0) return 0;
+		std::uint32_t k = clone(0);
+		if (w == 1) {
+			pool[k].val = *it;
+			++it; --rest;
+			return k;
+		}
+		std::uint32_t left = build(w / 2, it, rest);
+		std::uint32_t right = build(w / 2, it, rest);
+		pool[k].child[0] = left;
+		pool[k].child[1] = right;
+		pool[k].val = M(pool[left].val, pool[right].val);
+		return k;
+	}
+	type query(std::uint32_t k, std::size_t lo, std::size_t hi, std::size_t l, std::size_t r) const {
+		// fold of [l, r) in the subtree of node k, which covers [lo, hi)
+		if (k == 0 || r <= lo || hi <= l) return M.identity();
+		if (l <= lo && hi <= r) return pool[k].val;
+		std::size_t mid = (lo + hi) / 2;
+		return M(query(pool[k].child[0], lo, mid, l, r), query(pool[k].child[1], mid, hi, l, r));
+	}
+	void init() {
+		sz = 1; while (sz < n) sz *= 2;
+		node nd = { M.identity(), { 0, 0 } };
+		pool = std::vector<node>(1, nd);
+		base_nodes = 1;
+		init_version = 0;
+	}
+public:
+	explicit persistent_segment_tree() : n(0), M(Op()) { init(); };
+	explicit persistent_segment_tree(std::size_t n_, Op M_ = Op()) : n(n_), M(M_) { init(); }
+	template <class InputIterator>
+	explicit persistent_segment_tree(Op M_, InputIterator first, InputIterator last) : n(last - first), M(M_) {
+		init();
+		std::size_t rest = n;
+		init_version = build(sz, first, rest);
+		base_nodes = pool.size();
+	}
+	void reserve(std::size_t nodes) { pool.reserve(base_nodes + nodes); }
+	void clear() {
+		// frees all versions made by update() at once; the initial version and the capacity of the pool are kept
+		pool.erase(pool.begin() + base_nodes, pool.end());
+	}
+	std::size_t node_count() const { return pool.size() - 1; }
+	version initial() const { return init_version; }
+	version update(version ver, std::size_t pos, type nxtval) {
+		assert(0 <= pos && pos < n);
+		std::uint32_t path[64];
+		std::size_t depth = 0;
+		std::uint32_t root = clone(ver), k = root;
+		for (std::size_t w = sz; w > 1; w >>= 1) {
+			path[depth++] = k;
+			int dir = (pos & (w >> 1)) ? 1 : 0;
+			std::uint32_t c = clone(pool[k].child[dir]);
+			pool[k].child[dir] = c;
+			k = c;
+		}
+		pool[k].val = nxtval;
+		while (depth > 0) {
+			k = path[--depth];
+			pool[k].val = M(pool[pool[k].child[0]].val, pool[pool[k].child[1]].val);
+		}
+		return root;
+	}
+	type get(version ver, std::size_t pos) const {
+		assert(0 <= pos && pos < n);
+		std::uint32_t k = ver;
+		for (std::size_t w = sz; w > 1 && k != 0; w >>= 1) k = pool[k].child[(pos & (w >> 1)) ? 1 : 0];
+		return k != 0 ? pool[k].val : M.identity();
+	}
+	type range_query(version ver, std::size_t l, std::size_t r) const {
+		assert(0 <= l && l <= r && r <= n);
+		return query(ver, 0, sz, l, r);
+	}
+	std::size_t kth(version lo, version hi, type k) const {
+		// for counting trees (Op is sum): returns the smallest pos such that (count of [0, pos] in hi) - (count of [0, pos] in lo) > k
+		// with version i = "first i values are inserted", kth(ver[l], ver[r], k) is the k-th (0-indexed) smallest value in [l, r); n if none
+		if (range_query(hi, 0, n) - range_query(lo, 0, n) <= k) return n;
+		std::uint32_t a = lo, b = hi;
+		std::size_t pos = 0;
+		for (std::size_t w = sz; w > 1; w >>= 1) {
+			type cnt = pool[pool[b].child[0]].val - pool[pool[a].child[0]].val;
+			int dir = (k < cnt ? 0 : 1);
+			if (dir == 1) k -= cnt, pos += w >> 1;
+			a = pool[a].child[dir];
+			b = pool[b].child[dir];
+		}
+		return pos;
+	}
+};
+
+#endif // CLASS_PERSISTENT_SEGMENT_TREE
\ No newline at end of file
@@ -10,8 +10,9 @@ unsigned xorshift32() {
 	x ^= x << 5;
 	return x;
 }
-void test(int n, int q) {
-	segment_tree<unsigned> seg(n, monoid_min<unsigned>());
+template <class segment_tree_type, class monoid_type>
+void test(const char* name, int n, int q, monoid_type M) {
+	segment_tree_type seg(n, M);
 	for(int i = 0; i < n; ++i) {
 		seg.update(i, xorshift32());
 	}
@@ -27,14 +28,26 @@ void test(int n, int q) {
 		if(l > r) std::swap(l, r);
 		sum += seg.range_query(l, r + 1);
 	}
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		// first position where the running minimum from l drops below the threshold
+		int l = xorshift32() % n; unsigned threshold = xorshift32() >> 8;
+		sum += seg.max_right(l, [&](unsigned v) { return v >= threshold; });
+	}
 	chrono::system_clock::time_point finish = chrono::system_clock::now();
 	cout.precision(12);
 	std::chrono::duration<double> adding_duration = mid - start;
-	std::chrono::duration<double> getsum_duration = finish - mid;
-	cout << "---------- TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	std::chrono::duration<double> getsum_duration = mid2 - mid;
+	std::chrono::duration<double> search_duration = finish - mid2;
+	cout << "---------- TEST RESUTLTS (" << name << ", # of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
 	cout << "Answer: " << sum << endl;
 	cout << fixed << q << " Updates: " << adding_duration.count() << " seconds (" << adding_duration.count() / q << " seconds per query)" << endl;
 	cout << fixed << q << " Range Queries: " << getsum_duration.count() << " seconds (" << getsum_duration.count() / q << " seconds per element)" << endl;
+	cout << fixed << q << " Max Right Searches: " << search_duration.count() << " seconds (" << search_duration.count() / q << " seconds per query)" << endl;
+}
+void test(int n, int q) {
+	test<segment_tree<unsigned> >("monoid<unsigned>", n, q, monoid_min<unsigned>());
+	test<segment_tree<unsigned, static_monoid_min<unsigned> > >("static_monoid_min<unsigned>", n, q, static_monoid_min<unsigned>());
 }
 int main() {
 	test(1 << 18, 1 << 18);
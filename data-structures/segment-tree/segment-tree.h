@@ -19,20 +19,25 @@ public:
 	type operator()(type input1, type input2) const { return func_(input1, input2); }
 };
 
-template <class type>
+struct tree_image_access;
+
+template <class type, class Op = monoid<type> >
 class segment_tree {
+	// Op is either monoid<type> (type-erased, set at runtime) or a stateless policy such as static_monoid_min<type>,
+	// which has static identity() and operator() so that every combine can be inlined
 private:
 	std::size_t n, sz;
 	std::vector<type> val;
-	monoid<type> M;
+	Op M;
+	friend struct tree_image_access; // saving to a file (tree-image.h)
 public:
-	explicit segment_tree() : M(monoid<type>()), n(0), sz(0) {};
-	explicit segment_tree(std::size_t n_, monoid<type> M_) : n(n_), M(M_) {
+	explicit segment_tree() : n(0), sz(0), M(Op()) {};
+	explicit segment_tree(std::size_t n_, Op M_ = Op()) : n(n_), M(M_) {
 		sz = 1; while (sz < n) sz *= 2;
 		val = std::vector<type>(2 * sz, M.identity());
 	}
 	template <class InputIterator>
-	explicit segment_tree(monoid<type> M_, InputIterator first, InputIterator last) : M(M_), n(last - first) {
+	explicit segment_tree(Op M_, InputIterator first, InputIterator last) : n(last - first), M(M_) {
 		sz = 1; while (sz < n) sz *= 2;
 		val = std::vector<type>(2 * sz, M.identity());
 		std::size_t cur = sz;
@@ -49,10 +54,10 @@ public:
 		}
 	}
 	type operator[](std::size_t idx) const {
-		assert(0 <= pos && pos < n);
+		assert(0 <= idx && idx < n);
 		return val[sz + idx];
 	}
-	type range_query(type l, type r) const {
+	type range_query(std::size_t l, std::size_t r) const {
 		assert(0 <= l && l <= r && r <= n);
 		type ansl = M.identity(), ansr = M.identity();
 		l += sz; r += sz;
@@ -63,10 +68,64 @@ public:
 		}
 		return M(ansl, ansr);
 	}
+	template <class Predicate>
+	std::size_t max_right(std::size_t l, Predicate pred) const {
+		// returns the largest r such that pred(fold of [l, r)) is true, assuming pred is monotone and pred(identity) is true
+		assert(0 <= l && l <= n && pred(M.identity()));
+		if (l == n) return n;
+		l += sz;
+		type ans = M.identity();
+		do {
+			while (l % 2 == 0) l >>= 1;
+			if (!pred(M(ans, val[l]))) {
+				while (l < sz) {
+					l *= 2;
+					if (pred(M(ans, val[l]))) ans = M(ans, val[l]), ++l;
+				}
+				return l - sz;
+			}
+			ans = M(ans, val[l]), ++l;
+		} while ((l & (~l + 1)) != l);
+		return n;
+	}
+	template <class Predicate>
+	std::size_t min_left(std::size_t r, Predicate pred) const {
+		// returns the smallest l such that pred(fold of [l, r)) is true, assuming pred is monotone and pred(identity) is true
+		assert(0 <= r && r <= n && pred(M.identity()));
+		if (r == 0) return 0;
+		r += sz;
+		type ans = M.identity();
+		do {
+			--r;
+			while (r > 1 && r % 2 == 1) r >>= 1;
+			if (!pred(M(val[r], ans))) {
+				while (r < sz) {
+					r = r * 2 + 1;
+					if (pred(M(val[r], ans))) ans = M(val[r], ans), --r;
+				}
+				return r + 1 - sz;
+			}
+			ans = M(val[r], ans);
+		} while ((r & (~r + 1)) != r);
+		return 0;
+	}
 };
 
 template <class type> constexpr monoid<type> monoid_min() { return monoid<type>([&](type input1, type input2) { return std::min(input1, input2); }, std::numeric_limits<type>::max()); }
 template <class type> constexpr monoid<type> monoid_max() { return monoid<type>([&](type input1, type input2) { return std::max(input1, input2); }, std::numeric_limits<type>::min()); }
 template <class type> constexpr monoid<type> monoid_sum() { return monoid<type>([&](type input1, type input2) { return input1 + input2; }, type(0)); }
 
+template <class type> struct static_monoid_min {
+	static type identity() { return std::numeric_limits<type>::max(); }
+	type operator()(type input1, type input2) const { return std::min(input1, input2); }
+};
+template <class type> struct static_monoid_max {
+	static type identity() { return std::numeric_limits<type>::min(); }
+	type operator()(type input1, type input2) const { return std::max(input1, input2); }
+};
+template <class type> struct static_monoid_sum {
+	static type identity() { return type(0); }
+	type operator()(type input1, type input2) const { return input1 + input2; }
+};
+
 #endif // CLASS_SEGMENT_TREE
\ No newline at end of file
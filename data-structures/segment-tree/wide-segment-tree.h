@@ -0,0 +1,189 @@
+#ifndef CLASS_WIDE_SEGMENT_TREE
+#define CLASS_WIDE_SEGMENT_TREE
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "segment-tree.h"
+#include "../cache-aligned-allocator.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+template <class type, class Op, class Enable = void>
+struct wide_kernel {
+	// fold of block[lo, hi), where block is one node (one cache line)
+	static type reduce(const type* block, std::size_t lo, std::size_t hi) {
+		Op M;
+		type ans = Op::identity();
+		for (std::size_t i = lo; i < hi; ++i) ans = M(ans, block[i]);
+		return ans;
+	}
+};
+
+#ifdef __AVX2__
+template <class type> struct wide_lanes {};
+template <> struct wide_lanes<std::int32_t> {
+	static __m256i set1(std::int32_t x) { return _mm256_set1_epi32(x); }
+	static __m256i in_range(std::size_t base, std::size_t lo, std::size_t hi) {
+		// lanes base + i in [lo, hi)
+		__m256i idx = _mm256_add_epi32(_mm256_set1_epi32(std::int32_t(base)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+		return _mm256_and_si256(_mm256_cmpgt_epi32(idx, _mm256_set1_epi32(std::int32_t(lo) - 1)), _mm256_cmpgt_epi32(_mm256_set1_epi32(std::int32_t(hi)), idx));
+	}
+};
+template <> struct wide_lanes<std::int64_t> {
+	static __m256i set1(std::int64_t x) { return _mm256_set1_epi64x(x); }
+	static __m256i in_range(std::size_t base, std::size_t lo, std::size_t hi) {
+		__m256i idx = _mm256_add_epi64(_mm256_set1_epi64x(std::int64_t(base)), _mm256_setr_epi64x(0, 1, 2, 3));
+		return _mm256_and_si256(_mm256_cmpgt_epi64(idx, _mm256_set1_epi64x(std::int64_t(lo) - 1)), _mm256_cmpgt_epi64(_mm256_set1_epi64x(std::int64_t(hi)), idx));
+	}
+};
+template <> struct wide_lanes<std::uint32_t> : wide_lanes<std::int32_t> {
+	static __m256i set1(std::uint32_t x) { return _mm256_set1_epi32(std::int32_t(x)); }
+};
+template <> struct wide_lanes<std::uint64_t> : wide_lanes<std::int64_t> {
+	static __m256i set1(std::uint64_t x) { return _mm256_set1_epi64x(std::int64_t(x)); }
+};
+
+template <class type, class Op> struct wide_simd {};
+template <> struct wide_simd<std::int32_t, static_monoid_min<std::int32_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_min_epi32(a, b); } };
+template <> struct wide_simd<std::int32_t, static_monoid_max<std::int32_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_max_epi32(a, b); } };
+template <> struct wide_simd<std::int32_t, static_monoid_sum<std::int32_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); } };
+template <> struct wide_simd<std::uint32_t, static_monoid_min<std::uint32_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_min_epu32(a, b); } };
+template <> struct wide_simd<std::uint32_t, static_monoid_max<std::uint32_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_max_epu32(a, b); } };
+template <> struct wide_simd<std::uint32_t, static_monoid_sum<std::uint32_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); } };
+// AVX2 has no 64-bit min/max, so they are done by compare and blend (unsigned values are compared with flipped sign bits)
+template <> struct wide_simd<std::int64_t, static_monoid_min<std::int64_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); } };
+template <> struct wide_simd<std::int64_t, static_monoid_max<std::int64_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); } };
+template <> struct wide_simd<std::int64_t, static_monoid_sum<std::int64_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); } };
+template <> struct wide_simd<std::uint64_t, static_monoid_min<std::uint64_t> > {
+	typedef void enabled;
+	static __m256i combine(__m256i a, __m256i b) {
+		__m256i sign = _mm256_set1_epi64x(std::int64_t(1) << 63);
+		return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign)));
+	}
+};
+template <> struct wide_simd<std::uint64_t, static_monoid_max<std::uint64_t> > {
+	typedef void enabled;
+	static __m256i combine(__m256i a, __m256i b) {
+		__m256i sign = _mm256_set1_epi64x(std::int64_t(1) << 63);
+		return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign)));
+	}
+};
+template <> struct wide_simd<std::uint64_t, static_monoid_sum<std::uint64_t> > { typedef void enabled; static __m256i combine(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); } };
+
+template <class type, bool integral = std::is_integral<type>::value>
+struct wide_lane {
+	// the fixed-width type of the specializations above with the same size and signedness as type,
+	// so that long long and unsigned long long (which are not std::int64_t or std::uint64_t on LP64) use them too
+	typedef type lane;
+};
+template <class type>
+struct wide_lane<type, true> {
+	typedef typename std::conditional<std::is_signed<type>::value, std::int32_t, std::uint32_t>::type lane32;
+	typedef typename std::conditional<std::is_signed<type>::value, std::int64_t, std::uint64_t>::type lane64;
+	typedef typename std::conditional<sizeof(type) == 4, lane32, typename std::conditional<sizeof(type) == 8, lane64, type>::type>::type lane;
+};
+template <class Op, class type, class lane>
+struct wide_rebind { typedef Op op; };
+template <template <class> class Monoid, class type, class lane>
+struct wide_rebind<Monoid<type>, type, lane> { typedef Monoid<lane> op; }; // static_monoid_min<long long> -> static_monoid_min<std::int64_t>
+
+template <class type, class Op>
+struct wide_kernel<type, Op, typename wide_simd<typename wide_lane<type>::lane, typename wide_rebind<Op, type, typename wide_lane<type>::lane>::op>::enabled> {
+	// one node is two 256-bit vectors; lanes out of [lo, hi) are replaced by the identity before folding
+	typedef typename wide_lane<type>::lane lane;
+	typedef wide_simd<lane, typename wide_rebind<Op, type, lane>::op> simd;
+	static type reduce(const type* block, std::size_t lo, std::size_t hi) {
+		const std::size_t lanes = 32 / sizeof(type);
+		__m256i identity = wide_lanes<lane>::set1(lane(Op::identity()));
+		__m256i v0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+		__m256i v1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(block + lanes));
+		v0 = _mm256_blendv_epi8(identity, v0, wide_lanes<lane>::in_range(0, lo, hi));
+		v1 = _mm256_blendv_epi8(identity, v1, wide_lanes<lane>::in_range(lanes, lo, hi));
+		// horizontal fold by swapping halves: 128-bit, 64-bit, and 32-bit (only for 32-bit lanes)
+		__m256i v = simd::combine(v0, v1);
+		v = simd::combine(v, _mm256_permute2x128_si256(v, v, 1));
+		v = simd::combine(v, _mm256_shuffle_epi32(v, 0x4e));
+		if (lanes == 8) v = simd::combine(v, _mm256_shuffle_epi32(v, 0xb1));
+		return type(lanes == 8 ? std::uint32_t(_mm256_cvtsi256_si32(v)) : std::uint64_t(_mm_cvtsi128_si64(_mm256_castsi256_si128(v))));
+	}
+};
+#endif
+
+template <class type, class Op>
+class wide_segment_tree {
+	// B-ary segment tree: each node is one cache line of B = 64 / sizeof(type) values, which is the fold of B nodes of the level below
+	// Update and range query touch at most 2 cache lines per level, and there are only log_B(n) levels
+	// Op must be a stateless policy such as static_monoid_min<type>; folds of a node use AVX2 for 32/64-bit integers with min/max/sum
+public:
+	static const std::size_t B = 64 / sizeof(type);
+private:
+	static_assert(sizeof(type) <= 32 && 64 % sizeof(type) == 0, "type must fit in a cache line at least twice");
+	std::size_t n;
+	std::vector<type, cache_aligned_allocator<type> > val;
+	std::vector<std::size_t> offset; // level k is val[offset[k], offset[k + 1]); level 0 is the leaves
+	Op M;
+	void init() {
+		std::size_t len = (n + B - 1) / B * B;
+		if (len == 0) len = B;
+		offset = std::vector<std::size_t>(1, 0);
+		while (true) {
+			offset.push_back(offset.back() + len);
+			if (len == B) break;
+			len = (len / B + B - 1) / B * B;
+		}
+		val = std::vector<type, cache_aligned_allocator<type> >(offset.back(), M.identity());
+	}
+	void build() {
+		for (std::size_t k = 1; k + 1 < offset.size(); ++k) {
+			for (std::size_t i = offset[k]; i < offset[k + 1]; ++i) {
+				std::size_t child = offset[k - 1] + (i - offset[k]) * B;
+				if (child < offset[k]) val[i] = wide_kernel<type, Op>::reduce(&val[child], 0, B);
+			}
+		}
+	}
+public:
+	explicit wide_segment_tree() : n(0), M(Op()) { init(); };
+	explicit wide_segment_tree(std::size_t n_, Op M_ = Op()) : n(n_), M(M_) { init(); }
+	template <class InputIterator>
+	explicit wide_segment_tree(Op M_, InputIterator first, InputIterator last) : n(last - first), M(M_) {
+		init();
+		std::size_t cur = 0;
+		for (InputIterator it = first; it != last; ++it) val[cur++] = *it;
+		build();
+	}
+	void update(std::size_t pos, type nxtval) {
+		assert(0 <= pos && pos < n);
+		val[pos] = nxtval;
+		for (std::size_t k = 1; k + 1 < offset.size(); ++k) {
+			pos /= B;
+			val[offset[k] + pos] = wide_kernel<type, Op>::reduce(&val[offset[k - 1] + pos * B], 0, B);
+		}
+	}
+	type operator[](std::size_t idx) const {
+		assert(0 <= idx && idx < n);
+		return val[idx];
+	}
+	type range_query(std::size_t l, std::size_t r) const {
+		assert(0 <= l && l <= r && r <= n);
+		type ansl = M.identity(), ansr = M.identity();
+		for (std::size_t k = 0; l < r; ++k) {
+			const type* cur = &val[offset[k]];
+			std::size_t bl = l / B, br = r / B;
+			if (k + 2 == offset.size() || bl == br) {
+				// the top level is only one node
+				ansl = M(ansl, wide_kernel<type, Op>::reduce(cur + bl * B, l - bl * B, r - bl * B));
+				break;
+			}
+			if (l % B != 0) ansl = M(ansl, wide_kernel<type, Op>::reduce(cur + bl * B, l % B, B)), ++bl;
+			if (r % B != 0) ansr = M(wide_kernel<type, Op>::reduce(cur + br * B, 0, r % B), ansr);
+			l = bl; r = br;
+		}
+		return M(ansl, ansr);
+	}
+};
+
+#endif // CLASS_WIDE_SEGMENT_TREE
\ No newline at end of file
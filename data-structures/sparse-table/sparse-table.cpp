@@ -0,0 +1,53 @@
+#include "sparse-table.h"
+#include <chrono>
+#include <vector>
+#include <iostream>
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+template <class range_query_type>
+void test(const char* name, int n, int q) {
+	vector<unsigned> init(n);
+	for(int i = 0; i < n; ++i) {
+		init[i] = xorshift32();
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	range_query_type seg(monoid_min<unsigned>(), init.begin(), init.end());
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		int l = xorshift32() % n, r = xorshift32() % n;
+		if(l > r) std::swap(l, r);
+		sum += seg.range_query(l, r + 1);
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> build_duration = mid - start;
+	std::chrono::duration<double> query_duration = finish - mid;
+	cout << "---------- TEST RESUTLTS (" << name << ", # of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << endl;
+	cout << fixed << "Construction: " << build_duration.count() << " seconds (" << build_duration.count() / n << " seconds per element)" << endl;
+	cout << fixed << q << " Range Queries: " << query_duration.count() << " seconds (" << query_duration.count() / q << " seconds per query)" << endl;
+}
+void test(int n, int q) {
+	test<segment_tree<unsigned> >("segment_tree", n, q);
+	test<sparse_table<unsigned> >("sparse_table", n, q);
+}
+int main() {
+	test(1 << 18, 1 << 18);
+	test(1 << 19, 1 << 19);
+	test(1 << 20, 1 << 20);
+	test(1 << 21, 1 << 21);
+	test(1 << 22, 1 << 22);
+	test(1 << 23, 1 << 23);
+	test(1 << 24, 1 << 24);
+	test(1 << 25, 1 << 25);
+	test(1 << 26, 1 << 26);
+	test(1 << 27, 1 << 27);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef CLASS_SPARSE_TABLE
+#define CLASS_SPARSE_TABLE
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include "../segment-tree/segment-tree.h"
+
+template <class type, class Op = monoid<type> >
+class sparse_table {
+	// Static range query in O(1) for idempotent monoids (min, max, gcd, ...) with O(n) memory
+	// - Blocks of 64 elements: prefix / suffix folds in each block, and a sparse table over the folds of blocks
+	// - Queries inside a block: the monotone stack of the block up to each position is kept as a 64-bit mask,
+	//   and the answer is the lowest element of the stack in the range (valid when M(x, y) is always x or y, such as min and max)
+	//   For other monoids (such as gcd), such queries fold the elements one by one (at most 62 elements)
+private:
+	static const std::size_t B = 64;
+	std::size_t n, nb;
+	std::vector<type> val, prefix, suffix, table;
+	std::vector<std::uint64_t> mask;
+	std::vector<char> selective; // for each block
+	Op M;
+	static std::size_t log2(std::size_t x) {
+		std::size_t res = 0;
+		while (x >>= 1) ++res;
+		return res;
+	}
+	static std::size_t lowest_bit(std::uint64_t x) {
+#if defined(__GNUC__)
+		return __builtin_ctzll(x);
+#else
+		std::size_t res = 0;
+		while (!(x & 1)) x >>= 1, ++res;
+		return res;
+#endif
+	}
+	static std::size_t highest_bit(std::uint64_t x) {
+#if defined(__GNUC__)
+		return 63 - __builtin_clzll(x);
+#else
+		std::size_t res = 0;
+		while (x >>= 1) ++res;
+		return res;
+#endif
+	}
+public:
+	explicit sparse_table() : n(0), nb(0), M(Op()) {};
+	template <class InputIterator>
+	explicit sparse_table(Op M_, InputIterator first, InputIterator last) : n(last - first), M(M_) {
+		nb = (n + B - 1) / B;
+		val = std::vector<type>(first, last);
+		prefix = std::vector<type>(n);
+		suffix = std::vector<type>(n);
+		mask = std::vector<std::uint64_t>(n);
+		selective = std::vector<char>(nb, 1);
+		for (std::size_t b = 0; b < nb; ++b) {
+			std::size_t bs = b * B, be = std::min(bs + B, n);
+			std::uint64_t stack = 0;
+			for (std::size_t i = bs; i < be; ++i) {
+				prefix[i] = (i == bs ? val[i] : M(prefix[i - 1], val[i]));
+				while (stack != 0) {
+					std::size_t top = bs + highest_bit(stack);
+					type res = M(val[top], val[i]);
+					if (res == val[top]) break;
+					if (res != val[i]) {
+						selective[b] = 0;
+						break;
+					}
+					stack ^= std::uint64_t(1) << (top - bs);
+				}
+				stack |= std::uint64_t(1) << (i - bs);
+				mask[i] = stack;
+			}
+			for (std::size_t i = be; i-- > bs; ) {
+				suffix[i] = (i == be - 1 ? val[i] : M(val[i], suffix[i + 1]));
+			}
+		}
+		std::size_t levels = (nb == 0 ? 0 : log2(nb) + 1);
+		table = std::vector<type>(levels * nb);
+		for (std::size_t b = 0; b < nb; ++b) table[b] = prefix[std::min(b * B + B, n) - 1];
+		for (std::size_t k = 1; k < levels; ++k) {
+			for (std::size_t b = 0; b + (std::size_t(1) << k) <= nb; ++b) {
+				table[k * nb + b] = M(table[(k - 1) * nb + b], table[(k - 1) * nb + b + (std::size_t(1) << (k - 1))]);
+			}
+		}
+	}
+	std::size_t size() const { return n; }
+	type operator[](std::size_t idx) const {
+		assert(0 <= idx && idx < n);
+		return val[idx];
+	}
+	type range_query(std::size_t l, std::size_t r) const {
+		assert(0 <= l && l <= r && r <= n);
+		if (l == r) return M.identity();
+		--r; // from here, the range is [l, r]
+		std::size_t bl = l / B, br = r / B;
+		if (bl == br) {
+			if (l % B == 0) return prefix[r];
+			if (r % B == B - 1 || r == n - 1) return suffix[l];
+			if (selective[bl]) return val[bl * B + lowest_bit(mask[r] & (~std::uint64_t(0) << (l % B)))];
+			type ans = val[l];
+			for (std::size_t i = l + 1; i <= r; ++i) ans = M(ans, val[i]);
+			return ans;
+		}
+		type ans = suffix[l];
+		if (bl + 1 < br) {
+			std::size_t k = log2(br - bl - 1);
+			ans = M(ans, M(table[k * nb + bl + 1], table[k * nb + br - (std::size_t(1) << k)]));
+		}
+		return M(ans, prefix[r]);
+	}
+};
+
+#endif // CLASS_SPARSE_TABLE
\ No newline at end of file
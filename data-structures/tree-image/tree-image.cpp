@@ -0,0 +1,71 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <iostream>
+#include "tree-image.h"
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+void test(int n, int q) {
+	// restart of a service: building from the raw input again, against mapping the saved image
+	vector<long long> init(n);
+	for(int i = 0; i < n; ++i) {
+		init[i] = xorshift32() % 1024;
+	}
+	vector<int> ql(q), qr(q);
+	for(int i = 0; i < q; ++i) {
+		ql[i] = xorshift32() % n; qr[i] = xorshift32() % n;
+		if(ql[i] > qr[i]) std::swap(ql[i], qr[i]);
+		++qr[i];
+	}
+	const char* fenwick_path = "fenwick-tree.img";
+	const char* segment_path = "segment-tree.img";
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	fenwick_tree<long long> fen(init.begin(), init.end());
+	segment_tree<long long, static_monoid_min<long long> > seg(static_monoid_min<long long>(), init.begin(), init.end());
+	chrono::system_clock::time_point built = chrono::system_clock::now();
+	bool saved = save_image(fen, fenwick_path) && save_image(seg, segment_path);
+	chrono::system_clock::time_point written = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		sum += fen.getsum(ql[i], qr[i]) + seg.range_query(ql[i], qr[i]);
+	}
+	chrono::system_clock::time_point queried = chrono::system_clock::now();
+	mapped_fenwick_tree<long long> mfen(fenwick_path);
+	mapped_segment_tree<long long, static_monoid_min<long long> > mseg(segment_path);
+	chrono::system_clock::time_point mapped = chrono::system_clock::now();
+	long long sum2 = 0;
+	for(int i = 0; i < q; ++i) {
+		sum2 += mfen.getsum(ql[i], qr[i]) + mseg.range_query(ql[i], qr[i]);
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	bool opened = mfen.is_open() && mseg.is_open();
+	// a mismatched monoid is rejected
+	mapped_segment_tree<long long, static_monoid_max<long long> > wrong(segment_path);
+	remove(fenwick_path);
+	remove(segment_path);
+	cout.precision(12);
+	std::chrono::duration<double> build_duration = built - start;
+	std::chrono::duration<double> write_duration = written - built;
+	std::chrono::duration<double> query_duration = queried - written;
+	std::chrono::duration<double> map_duration = mapped - queried;
+	std::chrono::duration<double> mapped_query_duration = finish - mapped;
+	cout << "---------- TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << ' ' << sum2 << " (saved: " << saved << ", opened: " << opened << ", wrong monoid opened: " << wrong.is_open() << ")" << endl;
+	cout << fixed << "Building: " << build_duration.count() << " seconds" << endl;
+	cout << fixed << "Saving: " << write_duration.count() << " seconds" << endl;
+	cout << fixed << "Mapping: " << map_duration.count() << " seconds" << endl;
+	cout << fixed << q << " Queries: " << query_duration.count() << " seconds (" << query_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Queries (mapped): " << mapped_query_duration.count() << " seconds (" << mapped_query_duration.count() / q << " seconds per query)" << endl;
+}
+int main() {
+	for(int i = 18; i <= 24; i += 3) {
+		test(1 << i, 1 << 20);
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#ifndef CLASS_TREE_IMAGE
+#define CLASS_TREE_IMAGE
+
+#include <vector>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include "../fenwick-tree/fenwick-tree.h"
+#include "../segment-tree/segment-tree.h"
+
+// Binary images of fenwick_tree and segment_tree (POSIX only): a 64-byte header and the flat array val, written by one writev()
+// Loading maps the file by mmap(), and the mapped tree answers queries from the page cache right away, without rebuilding
+
+struct tree_image_header {
+	char magic[8]; // "TREEIMG"
+	std::uint32_t version;
+	std::uint32_t kind; // 1: fenwick_tree, 2: segment_tree
+	std::uint32_t type_tag; // (0: unsigned, 1: signed, 2: floating point) << 8 | sizeof(type)
+	std::uint32_t monoid_tag; // 1: min, 2: max, 3: sum, 0: any other monoid (not checked)
+	std::uint64_t n, sz, count; // count: the number of elements of val
+	std::uint64_t data_offset; // val starts here, 64-byte aligned
+	std::uint8_t padding[8];
+};
+static_assert(sizeof(tree_image_header) == 64, "the header must keep val 64-byte aligned");
+
+template <class type> struct image_type_tag {
+	static_assert(std::is_arithmetic<type>::value, "only arithmetic types can be saved");
+	static const std::uint32_t value = (std::is_floating_point<type>::value ? 2 : std::is_signed<type>::value ? 1 : 0) << 8 | sizeof(type);
+};
+template <class Op> struct image_monoid_tag { static const std::uint32_t value = 0; };
+template <class type> struct image_monoid_tag<static_monoid_min<type> > { static const std::uint32_t value = 1; };
+template <class type> struct image_monoid_tag<static_monoid_max<type> > { static const std::uint32_t value = 2; };
+template <class type> struct image_monoid_tag<static_monoid_sum<type> > { static const std::uint32_t value = 3; };
+
+struct tree_image_access {
+	template <class Tree> static std::size_t n(const Tree& tree) { return tree.n; }
+	template <class Tree> static std::size_t sz(const Tree& tree) { return tree.sz; }
+	template <class Tree> static const void* data(const Tree& tree) { return tree.val.data(); }
+	template <class Tree> static std::size_t count(const Tree& tree) { return tree.val.size(); }
+};
+
+inline bool write_tree_image(const char* path, tree_image_header header, const void* data, std::size_t bytes) {
+	// the header and the data in one writev(); it is repeated only when the kernel writes a part (more than 2 GB on Linux)
+	std::memcpy(header.magic, "TREEIMG", 8);
+	header.version = 1;
+	header.data_offset = sizeof(tree_image_header);
+	int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) return false;
+	iovec iov[2];
+	iov[0].iov_base = &header; iov[0].iov_len = sizeof(header);
+	iov[1].iov_base = const_cast<void*>(data); iov[1].iov_len = bytes;
+	std::size_t first = 0;
+	while (first < 2) {
+		ssize_t written = ::writev(fd, iov + first, int(2 - first));
+		if (written < 0 && errno == EINTR) continue;
+		if (written < 0) { ::close(fd); return false; }
+		std::size_t rest = std::size_t(written);
+		while (first < 2 && rest >= iov[first].iov_len) rest -= iov[first++].iov_len;
+		if (first < 2) {
+			iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + rest;
+			iov[first].iov_len -= rest;
+		}
+	}
+	return ::close(fd) == 0;
+}
+
+template <class type>
+bool save_image(const fenwick_tree<type>& tree, const char* path) {
+	tree_image_header header = tree_image_header();
+	header.kind = 1;
+	header.type_tag = image_type_tag<type>::value;
+	header.monoid_tag = 3;
+	header.n = tree_image_access::n(tree);
+	header.sz = tree_image_access::sz(tree);
+	header.count = tree_image_access::count(tree);
+	return write_tree_image(path, header, tree_image_access::data(tree), header.count * sizeof(type));
+}
+
+template <class type, class Op>
+bool save_image(const segment_tree<type, Op>& tree, const char* path) {
+	tree_image_header header = tree_image_header();
+	header.kind = 2;
+	header.type_tag = image_type_tag<type>::value;
+	header.monoid_tag = image_monoid_tag<Op>::value;
+	header.n = tree_image_access::n(tree);
+	header.sz = tree_image_access::sz(tree);
+	header.count = tree_image_access::count(tree);
+	return write_tree_image(path, header, tree_image_access::data(tree), header.count * sizeof(type));
+}
+
+class mapped_tree_image {
+	// the mapping of a whole image file; with writable = true, it is a private (copy-on-write) mapping, so updates change only the
+	// touched pages in memory and never the file
+private:
+	void* base;
+	std::size_t length;
+	mapped_tree_image(const mapped_tree_image&);
+	mapped_tree_image& operator=(const mapped_tree_image&);
+	bool valid_header(const tree_image_header* h, std::uint32_t kind, std::uint32_t type_tag, std::uint32_t monoid_tag) const {
+		// everything the queries rely on, so that a corrupt or truncated file is rejected instead of read out of bounds
+		std::uint64_t elem = type_tag & 255, sz = h->sz;
+		if (std::memcmp(h->magic, "TREEIMG", 8) != 0 || h->version != 1 || h->kind != kind || h->type_tag != type_tag) return false;
+		if (monoid_tag != 0 && h->monoid_tag != monoid_tag) return false;
+		// val must be aligned for type and lie inside the file (checked by division, which cannot overflow)
+		if (h->data_offset < sizeof(tree_image_header) || h->data_offset % 64 != 0 || h->data_offset > length) return false;
+		if (h->count > (length - h->data_offset) / elem) return false;
+		// sz is 0 (a default-constructed tree) or a power of two at least n, and count is sz + 1 (fenwick_tree) or 2 * sz (segment_tree)
+		if ((sz & (sz - 1)) != 0 || h->n > sz) return false;
+		if (kind == 1) return (sz == 0 ? h->count == 0 : h->count - 1 == sz);
+		return h->count % 2 == 0 && h->count / 2 == sz;
+	}
+protected:
+	const tree_image_header* header;
+	void* data;
+	mapped_tree_image(const char* path, bool writable, std::uint32_t kind, std::uint32_t type_tag, std::uint32_t monoid_tag) : base(0), length(0), header(0), data(0) {
+		int fd = ::open(path, O_RDONLY);
+		if (fd < 0) return;
+		struct stat st;
+		if (::fstat(fd, &st) == 0 && std::size_t(st.st_size) >= sizeof(tree_image_header)) {
+			void* ptr = ::mmap(0, std::size_t(st.st_size), PROT_READ | (writable ? PROT_WRITE : 0), MAP_PRIVATE, fd, 0);
+			if (ptr != MAP_FAILED) base = ptr, length = std::size_t(st.st_size);
+		}
+		::close(fd);
+		if (base == 0) return;
+		const tree_image_header* h = static_cast<const tree_image_header*>(base);
+		if (!valid_header(h, kind, type_tag, monoid_tag)) {
+			::munmap(base, length);
+			base = 0; length = 0;
+			return;
+		}
+		header = h;
+		data = static_cast<char*>(base) + h->data_offset;
+	}
+	~mapped_tree_image() {
+		if (base != 0) ::munmap(base, length);
+	}
+public:
+	bool is_open() const { return base != 0; }
+	void prefetch_all() const {
+		// asks the kernel to read the whole image ahead, when most of it will be touched soon
+		if (base != 0) ::madvise(base, length, MADV_WILLNEED);
+	}
+};
+
+template <class type>
+class mapped_fenwick_tree : public mapped_tree_image {
+	// fenwick_tree over a mapped image; the same getsum() and binary_search(), and add() if it is opened as writable
+private:
+	std::size_t n, sz;
+	type* val;
+	bool writable;
+public:
+	explicit mapped_fenwick_tree(const char* path, bool writable_ = false) : mapped_tree_image(path, writable_, 1, image_type_tag<type>::value, 3), n(0), sz(0), val(0), writable(writable_) {
+		if (is_open()) n = std::size_t(header->n), sz = std::size_t(header->sz), val = static_cast<type*>(data);
+	}
+	std::size_t size() const { return n; }
+	void add(std::size_t pos, type delta) {
+		assert(writable && 0 <= pos && pos < n);
+		for (std::size_t i = pos + 1; i <= sz; i += i & ~(i - 1)) {
+			val[i] += delta;
+		}
+	}
+	type getsum(std::size_t r) const {
+		assert(0 <= r && r <= n);
+		type ans = 0;
+		for (std::size_t i = r; i >= 1; i -= i & ~(i - 1)) {
+			ans += val[i];
+		}
+		return ans;
+	}
+	type getsum(std::size_t l, std::size_t r) const {
+		assert(0 <= l && l <= r && r <= n);
+		return getsum(r) - getsum(l);
+	}
+	std::size_t binary_search(type threshold) const {
+		std::size_t ans = 0;
+		for (std::size_t i = (sz >> 1); i >= 1; i >>= 1) {
+			if (threshold >= val[ans + i]) {
+				threshold -= val[ans + i];
+				ans += i;
+			}
+		}
+		return ans;
+	}
+};
+
+template <class type, class Op>
+class mapped_segment_tree : public mapped_tree_image {
+	// segment_tree over a mapped image, with the same range_query() and operator[], and update() if it is opened as writable
+	// Op is checked against the image when it is static_monoid_min/max/sum; any other Op must be the one used for saving
+private:
+	std::size_t n, sz;
+	type* val;
+	Op M;
+	bool writable;
+public:
+	explicit mapped_segment_tree(const char* path, bool writable_ = false, Op M_ = Op()) : mapped_tree_image(path, writable_, 2, image_type_tag<type>::value, image_monoid_tag<Op>::value), n(0), sz(0), val(0), M(M_), writable(writable_) {
+		if (is_open()) n = std::size_t(header->n), sz = std::size_t(header->sz), val = static_cast<type*>(data);
+	}
+	std::size_t size() const { return n; }
+	void update(std::size_t pos, type nxtval) {
+		assert(writable && 0 <= pos && pos < n);
+		pos += sz;
+		val[pos] = nxtval;
+		while (pos > 1) {
+			pos >>= 1;
+			val[pos] = M(val[pos * 2], val[pos * 2 + 1]);
+		}
+	}
+	type operator[](std::size_t idx) const {
+		assert(0 <= idx && idx < n);
+		return val[sz + idx];
+	}
+	type range_query(std::size_t l, std::size_t r) const {
+		assert(0 <= l && l <= r && r <= n);
+		type ansl = M.identity(), ansr = M.identity();
+		l += sz; r += sz;
+		while (l != r) {
+			if (l & 1) ansl = M(ansl, val[l]), ++l;
+			if (r & 1) --r, ansr = M(val[r], ansr);
+			l >>= 1; r >>= 1;
+		}
+		return M(ansl, ansr);
+	}
+};
+
+#endif // CLASS_TREE_IMAGE
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include "wavelet-matrix.h"
+#include "../segment-tree/persistent-segment-tree.h"
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+void test(int n, int q) {
+	// values in [0, n), compared with k-th smallest on persistent_segment_tree (version i counts the first i values)
+	vector<unsigned> init(n);
+	for(int i = 0; i < n; ++i) {
+		init[i] = xorshift32() % n;
+	}
+	vector<int> ql(q), qr(q), qk(q);
+	vector<unsigned> qv(q);
+	for(int i = 0; i < q; ++i) {
+		ql[i] = xorshift32() % n; qr[i] = xorshift32() % n;
+		if(ql[i] > qr[i]) std::swap(ql[i], qr[i]);
+		++qr[i];
+		qk[i] = xorshift32() % (qr[i] - ql[i]);
+		qv[i] = xorshift32() % n;
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	wavelet_matrix<unsigned> wm(init.begin(), init.end());
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	long long sum = 0, sum_kth = 0;
+	for(int i = 0; i < q; ++i) {
+		sum_kth += wm.kth_smallest(ql[i], qr[i], qk[i]);
+	}
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		sum += wm.range_freq(ql[i], qr[i], qv[i]);
+	}
+	chrono::system_clock::time_point mid3 = chrono::system_clock::now();
+	for(int i = 0; i < q; ++i) {
+		sum += wm.access(ql[i]) + wm.rank(qv[i], ql[i], qr[i]) + wm.select(qv[i], 0);
+	}
+	chrono::system_clock::time_point mid4 = chrono::system_clock::now();
+	persistent_segment_tree<int, static_monoid_sum<int> > cnt(n);
+	cnt.reserve(size_t(n) * 24);
+	vector<persistent_segment_tree<int, static_monoid_sum<int> >::version> pre(1, cnt.initial());
+	for(int i = 0; i < n; ++i) {
+		pre.push_back(cnt.update(pre.back(), init[i], cnt.get(pre.back(), init[i]) + 1));
+	}
+	chrono::system_clock::time_point mid5 = chrono::system_clock::now();
+	long long sum2 = 0;
+	for(int i = 0; i < q; ++i) {
+		sum2 += cnt.kth(pre[ql[i]], pre[qr[i]], qk[i]);
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> build_duration = mid - start;
+	std::chrono::duration<double> kth_duration = mid2 - mid;
+	std::chrono::duration<double> freq_duration = mid3 - mid2;
+	std::chrono::duration<double> other_duration = mid4 - mid3;
+	std::chrono::duration<double> pst_build_duration = mid5 - mid4;
+	std::chrono::duration<double> pst_kth_duration = finish - mid5;
+	cout << "---------- TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << ' ' << sum_kth << ' ' << sum2 << endl;
+	cout << fixed << "Building: " << build_duration.count() << " seconds (" << build_duration.count() / n << " seconds per element)" << endl;
+	cout << fixed << q << " K-th Smallest: " << kth_duration.count() << " seconds (" << kth_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Range Frequency: " << freq_duration.count() << " seconds (" << freq_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << q << " Access + Rank + Select: " << other_duration.count() << " seconds (" << other_duration.count() / q << " seconds per query)" << endl;
+	cout << fixed << "Building (persistent_segment_tree): " << pst_build_duration.count() << " seconds (" << pst_build_duration.count() / n << " seconds per element)" << endl;
+	cout << fixed << q << " K-th Smallest (persistent_segment_tree): " << pst_kth_duration.count() << " seconds (" << pst_kth_duration.count() / q << " seconds per query)" << endl;
+}
+int main() {
+	for(int i = 16; i <= 22; i += 2) {
+		test(1 << i, 1 << 20);
+	}
+	return 0;
+}
\ No newline at end of file
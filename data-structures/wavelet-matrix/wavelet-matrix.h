@@ -0,0 +1,227 @@
+#ifndef CLASS_WAVELET_MATRIX
+#define CLASS_WAVELET_MATRIX
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+class rank_bit_vector {
+	// bit vector with rank and select; a 32-bit count of ones is kept for every 4 words (256 bits), so the overhead is 1/8 of the bits
+	// rank() is one count plus at most 4 popcounts, and select() is a binary search on the counts between two samples and a scan of at most 4 words
+private:
+	std::size_t n;
+	std::vector<std::uint64_t> words;
+	std::vector<std::uint32_t> block; // block[b]: the number of ones before bit 256 * b
+	std::vector<std::uint32_t> sample1, sample0; // sample1[j]: the block of the (4096 j)-th one, which narrows the binary search of select
+	static const std::size_t sample_rate = 4096;
+	static std::size_t popcount(std::uint64_t w) {
+#if defined(__GNUC__) && defined(__POPCNT__)
+		return __builtin_popcountll(w);
+#else
+		// without the instruction, __builtin_popcountll is a library call, which is slower than this
+		w = w - ((w >> 1) & 0x5555555555555555ull);
+		w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+		w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0full;
+		return std::size_t((w * 0x0101010101010101ull) >> 56);
+#endif
+	}
+	static std::size_t select_in_word(std::uint64_t w, std::size_t k) {
+		// position of the k-th (0-indexed) one in w
+#ifdef __BMI2__
+		return std::size_t(__builtin_ctzll(_pdep_u64(std::uint64_t(1) << k, w)));
+#else
+		for (std::size_t i = 0; i < k; ++i) w &= w - 1;
+		std::size_t pos = 0;
+		while (!(w >> pos & 1)) ++pos;
+		return pos;
+#endif
+	}
+public:
+	rank_bit_vector() : n(0) {};
+	rank_bit_vector(std::size_t n_) : n(n_), words((n_ + 255) / 256 * 4 + 4), block(n_ / 256 + 2) {
+		assert(n < (std::size_t(1) << 32));
+	}
+	std::size_t size() const { return n; }
+	void set(std::size_t pos) { words[pos >> 6] |= std::uint64_t(1) << (pos & 63); }
+	void build() {
+		// call once after all set()
+		for (std::size_t b = 0; b + 1 < block.size(); ++b) {
+			std::size_t cnt = 0;
+			for (std::size_t j = 0; j < 4; ++j) cnt += popcount(words[4 * b + j]);
+			block[b + 1] = std::uint32_t(block[b] + cnt);
+		}
+		sample1.clear(); sample0.clear();
+		for (std::size_t b = 0; b + 1 < block.size(); ++b) {
+			// the samples in [block[b], block[b + 1]) are in the block b
+			while (sample1.size() * sample_rate < block[b + 1]) sample1.push_back(std::uint32_t(b));
+			while (sample0.size() * sample_rate < 256 * (b + 1) - block[b + 1]) sample0.push_back(std::uint32_t(b));
+		}
+		sample1.push_back(std::uint32_t(block.size() - 1));
+		sample0.push_back(std::uint32_t(block.size() - 1));
+	}
+	bool access(std::size_t pos) const { return words[pos >> 6] >> (pos & 63) & 1; }
+	std::size_t rank1(std::size_t pos) const {
+		// the number of ones in [0, pos)
+		std::size_t ans = block[pos >> 8];
+		for (std::size_t j = (pos >> 8) * 4; j < (pos >> 6); ++j) ans += popcount(words[j]);
+		if (pos & 63) ans += popcount(words[pos >> 6] << (64 - (pos & 63)));
+		return ans;
+	}
+	std::size_t rank0(std::size_t pos) const { return pos - rank1(pos); }
+	std::size_t select1(std::size_t k) const {
+		// position of the k-th (0-indexed) one; the number of ones must be more than k
+		std::size_t lo = sample1[k / sample_rate], hi = sample1[k / sample_rate + 1] + 1;
+		while (hi - lo > 1) {
+			std::size_t mid = (lo + hi) / 2;
+			if (block[mid] <= k) lo = mid;
+			else hi = mid;
+		}
+		k -= block[lo];
+		for (std::size_t j = lo * 4; ; ++j) {
+			std::size_t cnt = popcount(words[j]);
+			if (k < cnt) return j * 64 + select_in_word(words[j], k);
+			k -= cnt;
+		}
+	}
+	std::size_t select0(std::size_t k) const {
+		// position of the k-th (0-indexed) zero; the number of zeros must be more than k
+		std::size_t lo = sample0[k / sample_rate], hi = sample0[k / sample_rate + 1] + 1;
+		while (hi - lo > 1) {
+			std::size_t mid = (lo + hi) / 2;
+			if (256 * mid - block[mid] <= k) lo = mid;
+			else hi = mid;
+		}
+		k -= 256 * lo - block[lo];
+		for (std::size_t j = lo * 4; ; ++j) {
+			std::size_t cnt = 64 - popcount(words[j]);
+			if (k < cnt) return j * 64 + select_in_word(~words[j], k);
+			k -= cnt;
+		}
+	}
+};
+
+template <class type = std::uint64_t>
+class wavelet_matrix {
+	// Wavelet matrix over unsigned integers of lg bits: level d holds bit (lg - 1 - d) of the values, and the values are stably
+	// partitioned by the bit (zeros first) before the next level, so each level is built in a single pass
+	// access, rank, select, k-th smallest and frequency queries take O(lg) rank/select operations, with n lg (1 + 1/8) bits
+	static_assert(std::is_unsigned<type>::value, "values must be unsigned integers");
+private:
+	std::size_t n, lg;
+	std::vector<rank_bit_vector> level;
+	std::vector<std::size_t> zeros; // zeros[d]: the number of zeros at level d (the start of ones at level d + 1)
+	bool bit(type val, std::size_t d) const { return val >> (lg - 1 - d) & 1; }
+public:
+	wavelet_matrix() : n(0), lg(0) {};
+	template <class InputIterator>
+	wavelet_matrix(InputIterator first, InputIterator last, std::size_t lg_ = 0) : n(last - first), lg(lg_) {
+		// lg = 0 means the number of bits of the maximum value
+		std::vector<type> cur(first, last), nxt(n);
+		if (lg == 0) {
+			type mx = 0;
+			for (std::size_t i = 0; i < n; ++i) mx = (mx < cur[i] ? cur[i] : mx);
+			while (lg < sizeof(type) * 8 && (mx >> lg) != 0) ++lg;
+			if (lg == 0) lg = 1;
+		}
+		assert(lg <= sizeof(type) * 8);
+		for (std::size_t i = 0; i < n; ++i) assert(lg == sizeof(type) * 8 || (cur[i] >> lg) == 0);
+		level = std::vector<rank_bit_vector>(lg, rank_bit_vector(n));
+		zeros = std::vector<std::size_t>(lg);
+		for (std::size_t d = 0; d < lg; ++d) {
+			std::size_t z = 0;
+			for (std::size_t i = 0; i < n; ++i) {
+				if (bit(cur[i], d)) level[d].set(i);
+				else ++z;
+			}
+			level[d].build();
+			zeros[d] = z;
+			std::size_t pz = 0, po = z;
+			for (std::size_t i = 0; i < n; ++i) {
+				if (bit(cur[i], d)) nxt[po++] = cur[i];
+				else nxt[pz++] = cur[i];
+			}
+			cur.swap(nxt);
+		}
+	}
+	std::size_t size() const { return n; }
+	type access(std::size_t pos) const {
+		assert(0 <= pos && pos < n);
+		type ans = 0;
+		for (std::size_t d = 0; d < lg; ++d) {
+			if (level[d].access(pos)) ans |= type(1) << (lg - 1 - d), pos = zeros[d] + level[d].rank1(pos);
+			else pos = level[d].rank0(pos);
+		}
+		return ans;
+	}
+	std::size_t rank(type val, std::size_t l, std::size_t r) const {
+		// the number of val in [l, r)
+		assert(0 <= l && l <= r && r <= n);
+		if (lg < sizeof(type) * 8 && (val >> lg) != 0) return 0;
+		for (std::size_t d = 0; d < lg; ++d) {
+			if (bit(val, d)) l = zeros[d] + level[d].rank1(l), r = zeros[d] + level[d].rank1(r);
+			else l = level[d].rank0(l), r = level[d].rank0(r);
+		}
+		return r - l;
+	}
+	std::size_t rank(type val, std::size_t r) const { return rank(val, 0, r); }
+	std::size_t select(type val, std::size_t k) const {
+		// position of the k-th (0-indexed) val, or n if there are at most k of them
+		if (lg < sizeof(type) * 8 && (val >> lg) != 0) return n;
+		std::size_t l = 0, r = n;
+		for (std::size_t d = 0; d < lg; ++d) {
+			if (bit(val, d)) l = zeros[d] + level[d].rank1(l), r = zeros[d] + level[d].rank1(r);
+			else l = level[d].rank0(l), r = level[d].rank0(r);
+		}
+		if (l + k >= r) return n;
+		// going up: the position at level d + 1 comes from the k-th one (or zero) at level d
+		std::size_t pos = l + k;
+		for (std::size_t d = lg; d-- > 0; ) {
+			if (bit(val, d)) pos = level[d].select1(pos - zeros[d]);
+			else pos = level[d].select0(pos);
+		}
+		return pos;
+	}
+	type kth_smallest(std::size_t l, std::size_t r, std::size_t k) const {
+		// k-th (0-indexed) smallest value in [l, r)
+		assert(0 <= l && l <= r && r <= n && k < r - l);
+		type ans = 0;
+		for (std::size_t d = 0; d < lg; ++d) {
+			std::size_t l0 = level[d].rank0(l), r0 = level[d].rank0(r);
+			if (k < r0 - l0) l = l0, r = r0;
+			else {
+				k -= r0 - l0;
+				ans |= type(1) << (lg - 1 - d);
+				l = zeros[d] + (l - l0); r = zeros[d] + (r - r0);
+			}
+		}
+		return ans;
+	}
+	type kth_largest(std::size_t l, std::size_t r, std::size_t k) const {
+		assert(0 <= l && l <= r && r <= n && k < r - l);
+		return kth_smallest(l, r, r - l - 1 - k);
+	}
+	std::size_t range_freq(std::size_t l, std::size_t r, type upper) const {
+		// the number of values less than upper in [l, r)
+		assert(0 <= l && l <= r && r <= n);
+		if (lg < sizeof(type) * 8 && (upper >> lg) != 0) return r - l;
+		std::size_t ans = 0;
+		for (std::size_t d = 0; d < lg; ++d) {
+			std::size_t l0 = level[d].rank0(l), r0 = level[d].rank0(r);
+			if (bit(upper, d)) ans += r0 - l0, l = zeros[d] + (l - l0), r = zeros[d] + (r - r0);
+			else l = l0, r = r0;
+		}
+		return ans;
+	}
+	std::size_t range_freq(std::size_t l, std::size_t r, type lower, type upper) const {
+		// the number of values in [lower, upper) in [l, r)
+		assert(lower <= upper);
+		return range_freq(l, r, upper) - range_freq(l, r, lower);
+	}
+};
+
+#endif // CLASS_WAVELET_MATRIX
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "lu-decomposition.h"
+#include "../../number-theory/modint.h"
+#include <cmath>
+#include <chrono>
+#include <iostream>
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+double seconds(chrono::system_clock::time_point start, chrono::system_clock::time_point finish) {
+	std::chrono::duration<double> duration = finish - start;
+	return duration.count();
+}
+double residual(const matrix<double>& a, const matrix<double>& x, const matrix<double>& b) {
+	matrix<double> r = a * x - b;
+	double ans = 0.0;
+	for(size_t i = 0; i < r.rows(); ++i) {
+		for(size_t j = 0; j < r.cols(); ++j) {
+			ans = max(ans, fabs(r.entry(i, j)));
+		}
+	}
+	return ans;
+}
+template <class type>
+void test(const char* name, size_t n, size_t m, size_t q) {
+	// a system with m right-hand sides, solved by gaussian_elimination() and by lu_decomposition, and then q more single solves
+	matrix<type> a(n), b(n, m);
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			a.entry(i, j) = type(int(xorshift32() % 2001) - 1000);
+		}
+		for(size_t j = 0; j < m; ++j) {
+			b.entry(i, j) = type(int(xorshift32() % 2001) - 1000);
+		}
+	}
+	vector<vector<type> > single(q, vector<type>(n));
+	for(size_t i = 0; i < q; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			single[i][j] = type(int(xorshift32() % 2001) - 1000);
+		}
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	matrix<type> x1 = a.gaussian_elimination(b).second;
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	lu_decomposition<type> lu(a);
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	matrix<type> x2 = lu.solve_many(b);
+	chrono::system_clock::time_point mid3 = chrono::system_clock::now();
+	type sum = type(0);
+	for(size_t i = 0; i < q; ++i) {
+		sum += lu.solve(single[i])[i % n];
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	double gauss = seconds(start, mid), factor = seconds(mid, mid2), solve = seconds(mid2, mid3), singles = seconds(mid3, finish);
+	cout.precision(12);
+	cout << "---------- LU TEST RESUTLTS (" << name << ", " << n << " * " << n << ", " << m << " right-hand sides) ----------" << endl;
+	cout << fixed << "Gaussian Elimination: " << gauss << " seconds" << endl;
+	cout << fixed << "LU Factorization: " << factor << " seconds" << endl;
+	cout << fixed << "LU Solving: " << solve << " seconds (" << gauss / (factor + solve) << "x in total)" << endl;
+	cout << fixed << q << " Single Solves: " << singles << " seconds (" << singles / q << " seconds per solve)" << endl;
+	cout << "Answer: " << (x1 == x2 ? "same" : "different") << " solutions" << endl;
+	(void)sum;
+}
+template <>
+void test<double>(const char* name, size_t n, size_t m, size_t q) {
+	matrix<double> a(n), b(n, m);
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			a.entry(i, j) = double(xorshift32() % 2001) / 1000.0 - 1.0;
+		}
+		for(size_t j = 0; j < m; ++j) {
+			b.entry(i, j) = double(xorshift32() % 2001) / 1000.0 - 1.0;
+		}
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	matrix<double> x1 = a.gaussian_elimination(b).second;
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	lu_decomposition<double> lu(a);
+	chrono::system_clock::time_point mid2 = chrono::system_clock::now();
+	matrix<double> x2 = lu.solve_many(b);
+	chrono::system_clock::time_point mid3 = chrono::system_clock::now();
+	double sum = 0.0;
+	vector<double> single(n);
+	for(size_t i = 0; i < q; ++i) {
+		single[i % n] += 1.0;
+		sum += lu.solve(single)[i % n];
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	double gauss = seconds(start, mid), factor = seconds(mid, mid2), solve = seconds(mid2, mid3), singles = seconds(mid3, finish);
+	cout.precision(12);
+	cout << "---------- LU TEST RESUTLTS (" << name << ", " << n << " * " << n << ", " << m << " right-hand sides) ----------" << endl;
+	cout << fixed << "Gaussian Elimination: " << gauss << " seconds (residual " << residual(a, x1, b) << ")" << endl;
+	cout << fixed << "LU Factorization: " << factor << " seconds" << endl;
+	cout << fixed << "LU Solving: " << solve << " seconds (" << gauss / (factor + solve) << "x in total, residual " << residual(a, x2, b) << ")" << endl;
+	cout << fixed << q << " Single Solves: " << singles << " seconds (" << singles / q << " seconds per solve)" << endl;
+	cout << "Answer: " << sum << endl;
+}
+int main() {
+	for(size_t n = 256; n <= 1024; n *= 2) {
+		test<double>("double", n, 1000, 1000);
+		test<modint<998244353> >("modint", n, 1000, 1000);
+	}
+	return 0;
+}
\ No newline at end of file
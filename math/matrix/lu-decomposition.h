@@ -0,0 +1,166 @@
+#ifndef CLASS_LU_DECOMPOSITION
+#define CLASS_LU_DECOMPOSITION
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include "matrix.h"
+
+template <class type>
+class lu_decomposition {
+	// PA = LU of a square matrix, factored once and reused for any number of solves, det() and inverse()
+	// L (unit lower triangular) and U are stored together in one row-major array, and perm[i] is the row of A at row i of PA
+	// The pivot is the entry of the largest magnitude for floating types and the first nonzero one for exact types (matrix_pivot)
+	// Both the factorization and solve_many() are blocked: a panel of NB columns (or rows) is done by row operations,
+	// and the rest is updated with one product by matrix_multiply(), so that most of the work runs in the matrix kernel
+public:
+	static const std::size_t NB = 64;
+private:
+	std::size_t n;
+	std::vector<type> lu, diag_inv; // diag_inv[i] = 1 / U[i][i], for the solves
+	std::vector<std::size_t> perm;
+	bool odd, singular;
+	mutable std::vector<type> temp;
+	void subtract_product(std::size_t R, std::size_t K, std::size_t C, const type* a, std::size_t lda, const type* b, std::size_t ldb, type* c, std::size_t ldc) const {
+		// c -= a * b, through temp (which is the only state changed by the solves, so one object must not be shared by threads)
+		if (R == 0 || K == 0 || C == 0) return;
+		if (temp.size() < R * C) temp.resize(R * C);
+		matrix_multiply(R, K, C, a, lda, b, ldb, temp.data(), C);
+		for (std::size_t i = 0; i < R; ++i) {
+			type* dst = c + i * ldc;
+			const type* src = temp.data() + i * C;
+			for (std::size_t j = 0; j < C; ++j) dst[j] -= src[j];
+		}
+	}
+	void factor_panel(std::size_t k0, std::size_t k1) {
+		// unblocked elimination of the columns [k0, k1), with row swaps over whole rows; the columns after k1 are not updated
+		for (std::size_t i = k0; i < k1; ++i) {
+			std::size_t pos = i;
+			for (std::size_t j = i + 1; j < n; ++j) {
+				if (matrix_pivot<type>::better(lu[j * n + i], lu[pos * n + i])) pos = j;
+			}
+			if (pos != i) {
+				std::swap_ranges(lu.begin() + i * n, lu.begin() + (i + 1) * n, lu.begin() + pos * n);
+				std::swap(perm[i], perm[pos]);
+				odd = !odd;
+			}
+			if (lu[i * n + i] == type(0)) {
+				// the column is zero below the diagonal, so there is nothing to eliminate
+				singular = true;
+				continue;
+			}
+			type pivot_inv = matrix_scalar<type>::inverse(lu[i * n + i]);
+			for (std::size_t j = i + 1; j < n; ++j) {
+				if (lu[j * n + i] == type(0)) continue;
+				lu[j * n + i] *= pivot_inv;
+				matrix_scalar<type>::subtract_multiple(lu.data() + j * n + i + 1, lu.data() + i * n + i + 1, lu[j * n + i], k1 - i - 1);
+			}
+		}
+	}
+	void forward(type* x, std::size_t m) const {
+		// x (n * m) = L^-1 x
+		for (std::size_t k0 = 0; k0 < n; k0 += NB) {
+			std::size_t k1 = std::min(n, k0 + NB);
+			for (std::size_t i = k0; i < k1; ++i) {
+				for (std::size_t p = k0; p < i; ++p) {
+					if (lu[i * n + p] != type(0)) matrix_scalar<type>::subtract_multiple(x + i * m, x + p * m, lu[i * n + p], m);
+				}
+			}
+			subtract_product(n - k1, k1 - k0, m, lu.data() + k1 * n + k0, n, x + k0 * m, m, x + k1 * m, m);
+		}
+	}
+	void backward(type* x, std::size_t m) const {
+		// x (n * m) = U^-1 x
+		for (std::size_t k1 = n; k1 > 0; ) {
+			std::size_t k0 = (k1 > NB ? k1 - NB : 0);
+			for (std::size_t i = k1; i-- > k0; ) {
+				for (std::size_t p = i + 1; p < k1; ++p) {
+					if (lu[i * n + p] != type(0)) matrix_scalar<type>::subtract_multiple(x + i * m, x + p * m, lu[i * n + p], m);
+				}
+				for (std::size_t j = 0; j < m; ++j) x[i * m + j] *= diag_inv[i];
+			}
+			subtract_product(k0, k1 - k0, m, lu.data() + k0, n, x + k0 * m, m, x, m);
+			k1 = k0;
+		}
+	}
+public:
+	lu_decomposition() : n(0), odd(false), singular(false) {}
+	explicit lu_decomposition(const matrix<type>& mat) { factor(mat); }
+	bool factor(const matrix<type>& mat) {
+		// returns false if mat is singular (then det() is 0, and the solves and inverse() must not be used)
+		assert(mat.rows() == mat.cols());
+		n = mat.rows();
+		lu.resize(n * n);
+		for (std::size_t i = 0; i < n; ++i) {
+			for (std::size_t j = 0; j < n; ++j) lu[i * n + j] = mat.entry(i, j);
+		}
+		perm.resize(n);
+		for (std::size_t i = 0; i < n; ++i) perm[i] = i;
+		odd = false;
+		singular = false;
+		for (std::size_t k0 = 0; k0 < n; k0 += NB) {
+			std::size_t k1 = std::min(n, k0 + NB);
+			factor_panel(k0, k1);
+			// U12 = L11^-1 A12 by row operations, and then A22 -= L21 U12
+			for (std::size_t i = k0; i < k1; ++i) {
+				for (std::size_t p = k0; p < i; ++p) {
+					if (lu[i * n + p] != type(0)) matrix_scalar<type>::subtract_multiple(lu.data() + i * n + k1, lu.data() + p * n + k1, lu[i * n + p], n - k1);
+				}
+			}
+			subtract_product(n - k1, k1 - k0, n - k1, lu.data() + k1 * n + k0, n, lu.data() + k0 * n + k1, n, lu.data() + k1 * n + k1, n);
+		}
+		diag_inv.assign(n, type(0));
+		if (!singular) {
+			for (std::size_t i = 0; i < n; ++i) diag_inv[i] = matrix_scalar<type>::inverse(lu[i * n + i]);
+		}
+		return !singular;
+	}
+	std::size_t size() const { return n; }
+	bool is_singular() const { return singular; }
+	type det() const {
+		type ans = (odd ? type(0) - type(1) : type(1));
+		for (std::size_t i = 0; i < n; ++i) ans *= lu[i * n + i];
+		return ans;
+	}
+	std::vector<type> solve(const std::vector<type>& b) const {
+		// x such that A x = b
+		assert(!singular && b.size() == n);
+		// one column, so the substitutions are dot products along the rows of L and U
+		std::vector<type> x(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			const type* row = lu.data() + i * n;
+			type sum = b[perm[i]];
+			for (std::size_t p = 0; p < i; ++p) sum -= row[p] * x[p];
+			x[i] = sum;
+		}
+		for (std::size_t i = n; i-- > 0; ) {
+			const type* row = lu.data() + i * n;
+			type sum = x[i];
+			for (std::size_t p = i + 1; p < n; ++p) sum -= row[p] * x[p];
+			x[i] = sum * diag_inv[i];
+		}
+		return x;
+	}
+	matrix<type> solve_many(const matrix<type>& b) const {
+		// X such that A X = B, for all columns of B at once
+		assert(!singular && b.rows() == n);
+		std::size_t m = b.cols();
+		matrix<type> x(n, m);
+		for (std::size_t i = 0; i < n; ++i) {
+			for (std::size_t j = 0; j < m; ++j) x.entry(i, j) = b.entry(perm[i], j);
+		}
+		if (n != 0 && m != 0) {
+			forward(&x.entry(0, 0), m);
+			backward(&x.entry(0, 0), m);
+		}
+		return x;
+	}
+	matrix<type> inverse() const {
+		assert(!singular);
+		return solve_many(matrix<type>::unit(n));
+	}
+};
+
+#endif // CLASS_LU_DECOMPOSITION
\ No newline at end of file
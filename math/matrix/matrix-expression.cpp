@@ -0,0 +1,94 @@
+#include "matrix.h"
+#include <new>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+size_t allocations = 0;
+void* operator new(size_t size) {
+	++allocations;
+	void* ptr = malloc(size == 0 ? 1 : size);
+	if(ptr == 0) throw bad_alloc();
+	return ptr;
+}
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+matrix<double> random_matrix(size_t n) {
+	matrix<double> ret(n);
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			ret.entry(i, j) = (double(xorshift32() % 2001) - 1000.0) / 1000.0 / double(n);
+		}
+	}
+	return ret;
+}
+void report(const char* name, size_t q, size_t allocs, chrono::system_clock::time_point start, chrono::system_clock::time_point finish) {
+	std::chrono::duration<double> duration = finish - start;
+	cout << fixed << name << ": " << duration.count() << " seconds (" << duration.count() / q << " seconds and " << double(allocs) / q << " allocations per iteration)" << endl;
+}
+void test(size_t n, size_t q) {
+	matrix<double> d = random_matrix(n), I = matrix<double>::unit(n), a = random_matrix(n), b = random_matrix(n);
+	double sum = 0.0, sum2 = 0.0;
+	cout.precision(12);
+	cout << "---------- EXPRESSION TEST RESUTLTS (" << n << " * " << n << ", " << q << " iterations) ----------" << endl;
+	// d - I * 4 - I * i, with each operator evaluated to a matrix (as the operators used to) and as one expression
+	size_t allocs = allocations;
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	for(size_t i = 0; i < q; ++i) {
+		matrix<double> t1 = I * 4.0;
+		matrix<double> t2 = d - t1;
+		matrix<double> t3 = I * double(i % 21);
+		matrix<double> t4 = t2 - t3;
+		sum += t4.determinant();
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	report("Determinant (temporaries)", q, allocations - allocs, start, finish);
+	allocs = allocations;
+	start = chrono::system_clock::now();
+	for(size_t i = 0; i < q; ++i) {
+		sum2 += (d - I * 4 - I * double(i % 21)).determinant();
+	}
+	finish = chrono::system_clock::now();
+	report("Determinant (expression)", q, allocations - allocs, start, finish);
+	// products: a new matrix for each product, and one buffer reused by matrix::multiply
+	matrix<double> c;
+	allocs = allocations;
+	start = chrono::system_clock::now();
+	for(size_t i = 0; i < q; ++i) {
+		c = a * b;
+		sum += c.entry(i % n, 0);
+	}
+	finish = chrono::system_clock::now();
+	report("Product (operator*)", q, allocations - allocs, start, finish);
+	allocs = allocations;
+	start = chrono::system_clock::now();
+	for(size_t i = 0; i < q; ++i) {
+		matrix<double>::multiply(a, b, c);
+		sum2 += c.entry(i % n, 0);
+	}
+	finish = chrono::system_clock::now();
+	report("Product (multiply into a buffer)", q, allocations - allocs, start, finish);
+	allocs = allocations;
+	start = chrono::system_clock::now();
+	for(size_t i = 0; i < q; ++i) {
+		c = (a + I).pow(16);
+		sum += c.entry(0, i % n);
+		sum2 += c.entry(0, i % n);
+	}
+	finish = chrono::system_clock::now();
+	report("Power (16)", q, allocations - allocs, start, finish);
+	cout << "Answer: " << sum << ' ' << sum2 << endl;
+}
+int main() {
+	test(2, 1 << 20);
+	test(16, 1 << 16);
+	test(128, 1 << 8);
+	return 0;
+}
\ No newline at end of file
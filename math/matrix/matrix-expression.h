@@ -0,0 +1,136 @@
+#ifndef CLASS_MATRIX_EXPRESSION
+#define CLASS_MATRIX_EXPRESSION
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+template <class type> class matrix;
+
+template <class E, class type>
+class matrix_expression {
+	// base of matrix and of the lazy element-wise expressions (+, - of matrices, and +, -, * with a scalar)
+	// an expression is evaluated in one pass when it is converted or assigned to a matrix, with no temporary matrices;
+	// temporary matrices are moved into it, and named ones are referred to, so it must not outlive the named matrices in it
+public:
+	typedef type value_type;
+	const E& derived() const { return static_cast<const E&>(*this); }
+	std::size_t rows() const { return derived().rows(); }
+	std::size_t cols() const { return derived().cols(); }
+	type element(std::size_t i) const { return derived().element(i); } // the i-th element in row-major order
+	type entry(std::size_t r, std::size_t c) const { return element(r * cols() + c); }
+	matrix<type> eval() const { return matrix<type>(derived()); }
+	matrix<type> transpose() const { return eval().transpose(); }
+	matrix<type> pow(std::uint64_t b) const { return eval().pow(b); }
+	matrix<type> inverse() const { return eval().inverse(); }
+	type determinant() const { return eval().determinant(); }
+	std::pair<matrix<type>, matrix<type> > gaussian_elimination(const matrix<type>& mat) const { return eval().gaussian_elimination(mat); }
+	bool operator==(const matrix<type>& mat) const { return eval() == mat; }
+	bool operator!=(const matrix<type>& mat) const { return eval() != mat; }
+};
+
+template <class T, class Enable = void>
+struct is_matrix_expression : std::false_type {};
+template <class T>
+struct is_matrix_expression<T, typename std::enable_if<std::is_base_of<matrix_expression<T, typename T::value_type>, T>::value>::type> : std::true_type {};
+
+template <class X>
+struct matrix_operand {
+	// how an operand of the forwarding operators below is held: expressions and temporary matrices by value (moved in),
+	// and named matrices by reference
+	typedef typename std::decay<X>::type type;
+};
+template <class T>
+struct matrix_operand<matrix<T>&> {
+	typedef const matrix<T>& type;
+};
+template <class T>
+struct matrix_operand<const matrix<T>&> {
+	typedef const matrix<T>& type;
+};
+
+template <class L, class R, class Enable = void>
+struct matrix_binary_enable {};
+template <class L, class R>
+struct matrix_binary_enable<L, R, typename std::enable_if<is_matrix_expression<typename std::decay<L>::type>::value && is_matrix_expression<typename std::decay<R>::type>::value
+	&& std::is_same<typename std::decay<L>::type::value_type, typename std::decay<R>::type::value_type>::value>::type> {
+	typedef typename std::decay<L>::type::value_type type;
+};
+template <class E, class Enable = void>
+struct matrix_scalar_enable {};
+template <class E>
+struct matrix_scalar_enable<E, typename std::enable_if<is_matrix_expression<typename std::decay<E>::type>::value>::type> {
+	typedef typename std::decay<E>::type::value_type type;
+};
+
+template <class L, class R, class Op>
+class matrix_binary_expression : public matrix_expression<matrix_binary_expression<L, R, Op>, typename std::decay<L>::type::value_type> {
+	// L and R are the types of the members given by matrix_operand
+private:
+	L lhs;
+	R rhs;
+public:
+	template <class L_, class R_>
+	matrix_binary_expression(L_&& lhs_, R_&& rhs_) : lhs(std::forward<L_>(lhs_)), rhs(std::forward<R_>(rhs_)) {
+		assert(lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols());
+	}
+	std::size_t rows() const { return lhs.rows(); }
+	std::size_t cols() const { return lhs.cols(); }
+	typename std::decay<L>::type::value_type element(std::size_t i) const { return Op()(lhs.element(i), rhs.element(i)); }
+};
+
+template <class E, class Op>
+class matrix_scalar_expression : public matrix_expression<matrix_scalar_expression<E, Op>, typename std::decay<E>::type::value_type> {
+private:
+	typedef typename std::decay<E>::type::value_type type;
+	E lhs;
+	type x;
+public:
+	template <class E_>
+	matrix_scalar_expression(E_&& lhs_, const type& x_) : lhs(std::forward<E_>(lhs_)), x(x_) {}
+	std::size_t rows() const { return lhs.rows(); }
+	std::size_t cols() const { return lhs.cols(); }
+	type element(std::size_t i) const { return Op()(lhs.element(i), x); }
+};
+
+// forwarding references, so that temporaries can be moved in; they are also better matches than the conversion of a scalar
+// to a matrix by matrix(std::size_t), so that I * 4 is the scalar product
+template <class L, class R>
+matrix_binary_expression<typename matrix_operand<L>::type, typename matrix_operand<R>::type, std::plus<typename matrix_binary_enable<L, R>::type> > operator+(L&& lhs, R&& rhs) {
+	return matrix_binary_expression<typename matrix_operand<L>::type, typename matrix_operand<R>::type, std::plus<typename matrix_binary_enable<L, R>::type> >(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+template <class L, class R>
+matrix_binary_expression<typename matrix_operand<L>::type, typename matrix_operand<R>::type, std::minus<typename matrix_binary_enable<L, R>::type> > operator-(L&& lhs, R&& rhs) {
+	return matrix_binary_expression<typename matrix_operand<L>::type, typename matrix_operand<R>::type, std::minus<typename matrix_binary_enable<L, R>::type> >(std::forward<L>(lhs), std::forward<R>(rhs));
+}
+template <class E>
+matrix_scalar_expression<typename matrix_operand<E>::type, std::plus<typename matrix_scalar_enable<E>::type> > operator+(E&& lhs, const typename matrix_scalar_enable<E>::type& x) {
+	return matrix_scalar_expression<typename matrix_operand<E>::type, std::plus<typename matrix_scalar_enable<E>::type> >(std::forward<E>(lhs), x);
+}
+template <class E>
+matrix_scalar_expression<typename matrix_operand<E>::type, std::minus<typename matrix_scalar_enable<E>::type> > operator-(E&& lhs, const typename matrix_scalar_enable<E>::type& x) {
+	return matrix_scalar_expression<typename matrix_operand<E>::type, std::minus<typename matrix_scalar_enable<E>::type> >(std::forward<E>(lhs), x);
+}
+template <class E>
+matrix_scalar_expression<typename matrix_operand<E>::type, std::multiplies<typename matrix_scalar_enable<E>::type> > operator*(E&& lhs, const typename matrix_scalar_enable<E>::type& x) {
+	return matrix_scalar_expression<typename matrix_operand<E>::type, std::multiplies<typename matrix_scalar_enable<E>::type> >(std::forward<E>(lhs), x);
+}
+
+template <class L, class R, class type>
+matrix<type> operator*(const matrix_expression<L, type>& lhs, const matrix_expression<R, type>& rhs) {
+	// matrix products are not element-wise, so the operands are evaluated first (a matrix times a matrix is a member of matrix)
+	return lhs.eval() * rhs.eval();
+}
+template <class E, class type>
+matrix<type> operator*(const matrix_expression<E, type>& lhs, const matrix<type>& rhs) {
+	return lhs.eval() * rhs;
+}
+template <class E, class type>
+matrix<type> operator*(const matrix<type>& lhs, const matrix_expression<E, type>& rhs) {
+	return lhs * rhs.eval();
+}
+
+#endif // CLASS_MATRIX_EXPRESSION
\ No newline at end of file
@@ -0,0 +1,143 @@
+#ifndef CLASS_MATRIX_KERNEL
+#define CLASS_MATRIX_KERNEL
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include "thread-pool.h"
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+template <class type, class Enable = void>
+struct matrix_kernel {
+	// the micro-kernel and the block sizes of matrix_multiply(); specializations replace all of them for a type
+	// micro() adds the product of a packed panel of A (kc * MR, column by column) and a packed panel of B (kc * NR, row by row)
+	// to the tile c (mr * nr of it, with leading dimension ldc); MR * NR accumulators are kept in registers as far as possible
+	static const std::size_t MR = 4, NR = 8; // register tile
+	static const std::size_t MC = 128, KC = 256, NC = 1024; // a block of A (MC * KC) stays in L2, a panel of B (KC * NR) in L1
+	static void micro(std::size_t kc, const type* a, const type* b, type* c, std::size_t ldc, std::size_t mr, std::size_t nr) {
+		type acc[MR][NR];
+		for (std::size_t i = 0; i < MR; ++i) {
+			for (std::size_t j = 0; j < NR; ++j) acc[i][j] = type();
+		}
+		for (std::size_t k = 0; k < kc; ++k, a += MR, b += NR) {
+			for (std::size_t i = 0; i < MR; ++i) {
+				for (std::size_t j = 0; j < NR; ++j) acc[i][j] += a[i] * b[j];
+			}
+		}
+		for (std::size_t i = 0; i < mr; ++i) {
+			for (std::size_t j = 0; j < nr; ++j) c[i * ldc + j] += acc[i][j];
+		}
+	}
+};
+
+template <class type, class Enable = void>
+struct matrix_scalar {
+	// the division and the row operation of gaussian_elimination() and determinant(), specialized for modular types (matrix-modint.h)
+	static type inverse(const type& x) { return type(1) / x; }
+	static void subtract_multiple(type* dst, const type* src, type mult, std::size_t len) {
+		// dst[k] -= src[k] * mult
+		for (std::size_t k = 0; k < len; ++k) dst[k] -= src[k] * mult;
+	}
+};
+
+#if defined(__AVX2__) && defined(__FMA__)
+template <>
+struct matrix_kernel<double> {
+	// 6 * 8 tile in 12 ymm registers, with one broadcast of A and two loads of B for 12 FMAs
+	static const std::size_t MR = 6, NR = 8;
+	static const std::size_t MC = 96, KC = 256, NC = 2048;
+	static void micro(std::size_t kc, const double* a, const double* b, double* c, std::size_t ldc, std::size_t mr, std::size_t nr) {
+		__m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd(), c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+		__m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd(), c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+		__m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd(), c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+		for (std::size_t k = 0; k < kc; ++k, a += MR, b += NR) {
+			__m256d b0 = _mm256_loadu_pd(b), b1 = _mm256_loadu_pd(b + 4), x;
+			x = _mm256_broadcast_sd(a + 0); c00 = _mm256_fmadd_pd(x, b0, c00); c01 = _mm256_fmadd_pd(x, b1, c01);
+			x = _mm256_broadcast_sd(a + 1); c10 = _mm256_fmadd_pd(x, b0, c10); c11 = _mm256_fmadd_pd(x, b1, c11);
+			x = _mm256_broadcast_sd(a + 2); c20 = _mm256_fmadd_pd(x, b0, c20); c21 = _mm256_fmadd_pd(x, b1, c21);
+			x = _mm256_broadcast_sd(a + 3); c30 = _mm256_fmadd_pd(x, b0, c30); c31 = _mm256_fmadd_pd(x, b1, c31);
+			x = _mm256_broadcast_sd(a + 4); c40 = _mm256_fmadd_pd(x, b0, c40); c41 = _mm256_fmadd_pd(x, b1, c41);
+			x = _mm256_broadcast_sd(a + 5); c50 = _mm256_fmadd_pd(x, b0, c50); c51 = _mm256_fmadd_pd(x, b1, c51);
+		}
+		double acc[MR * NR];
+		_mm256_storeu_pd(acc + 0, c00); _mm256_storeu_pd(acc + 4, c01);
+		_mm256_storeu_pd(acc + 8, c10); _mm256_storeu_pd(acc + 12, c11);
+		_mm256_storeu_pd(acc + 16, c20); _mm256_storeu_pd(acc + 20, c21);
+		_mm256_storeu_pd(acc + 24, c30); _mm256_storeu_pd(acc + 28, c31);
+		_mm256_storeu_pd(acc + 32, c40); _mm256_storeu_pd(acc + 36, c41);
+		_mm256_storeu_pd(acc + 40, c50); _mm256_storeu_pd(acc + 44, c51);
+		for (std::size_t i = 0; i < mr; ++i) {
+			for (std::size_t j = 0; j < nr; ++j) c[i * ldc + j] += acc[i * NR + j];
+		}
+	}
+};
+#endif
+
+template <class type>
+void matrix_multiply(std::size_t R, std::size_t K, std::size_t C, const type* a, std::size_t lda, const type* b, std::size_t ldb, type* c, std::size_t ldc) {
+	// c (R * C) = a (R * K) * b (K * C), all row-major; c must not overlap a or b
+	// Blocked in the order of BLIS: a block of B (KC * NC) and a block of A (MC * KC) are packed into panels, and each pair of panels
+	// goes to the micro-kernel; the packing buffers are per thread and kept between calls
+	typedef matrix_kernel<type> kernel;
+	const std::size_t MR = kernel::MR, NR = kernel::NR, MC = kernel::MC, KC = kernel::KC, NC = kernel::NC;
+	static thread_local std::vector<type> apack, bpack;
+	if (apack.size() < MC * KC) apack.resize(MC * KC);
+	if (bpack.size() < KC * ((NC + NR - 1) / NR * NR)) bpack.resize(KC * ((NC + NR - 1) / NR * NR));
+	for (std::size_t i = 0; i < R; ++i) std::fill(c + i * ldc, c + i * ldc + C, type());
+	for (std::size_t jc = 0; jc < C; jc += NC) {
+		std::size_t nc = std::min(NC, C - jc);
+		for (std::size_t pc = 0; pc < K; pc += KC) {
+			std::size_t kc = std::min(KC, K - pc);
+			// B[pc, pc + kc) * [jc, jc + nc) into panels of NR columns, padded with zeros
+			for (std::size_t jr = 0; jr < nc; jr += NR) {
+				type* dst = &bpack[jr * kc];
+				std::size_t nr = std::min(NR, nc - jr);
+				for (std::size_t k = 0; k < kc; ++k, dst += NR) {
+					const type* src = b + (pc + k) * ldb + jc + jr;
+					for (std::size_t j = 0; j < nr; ++j) dst[j] = src[j];
+					for (std::size_t j = nr; j < NR; ++j) dst[j] = type();
+				}
+			}
+			for (std::size_t ic = 0; ic < R; ic += MC) {
+				std::size_t mc = std::min(MC, R - ic);
+				// A[ic, ic + mc) * [pc, pc + kc) into panels of MR rows, padded with zeros
+				for (std::size_t ir = 0; ir < mc; ir += MR) {
+					type* dst = &apack[ir * kc];
+					std::size_t mr = std::min(MR, mc - ir);
+					for (std::size_t k = 0; k < kc; ++k, dst += MR) {
+						for (std::size_t i = 0; i < mr; ++i) dst[i] = a[(ic + ir + i) * lda + pc + k];
+						for (std::size_t i = mr; i < MR; ++i) dst[i] = type();
+					}
+				}
+				for (std::size_t jr = 0; jr < nc; jr += NR) {
+					for (std::size_t ir = 0; ir < mc; ir += MR) {
+						kernel::micro(kc, &apack[ir * kc], &bpack[jr * kc], c + (ic + ir) * ldc + jc + jr, ldc, std::min(MR, mc - ir), std::min(NR, nc - jr));
+					}
+				}
+			}
+		}
+	}
+}
+
+template <class type>
+void matrix_multiply(std::size_t R, std::size_t K, std::size_t C, const type* a, std::size_t lda, const type* b, std::size_t ldb, type* c, std::size_t ldc, thread_pool& pool) {
+	// the same as above, with tiles of c (rows in multiples of MR, columns in blocks of NC) shared among the threads of pool
+	// each tile packs its own blocks of B, which costs about 1 / (2 * rows of the tile) of its multiplications
+	typedef matrix_kernel<type> kernel;
+	const std::size_t MR = kernel::MR, NC = kernel::NC;
+	std::size_t tasks = 4 * pool.size();
+	std::size_t rows = (R + tasks - 1) / tasks;
+	rows = std::max(MR, (rows + MR - 1) / MR * MR);
+	std::size_t row_tiles = (R + rows - 1) / rows, col_tiles = (C + NC - 1) / NC;
+	pool.parallel_for(0, row_tiles * col_tiles, 1, [&](std::size_t first, std::size_t last) {
+		for (std::size_t t = first; t < last; ++t) {
+			std::size_t r0 = t / col_tiles * rows, c0 = t % col_tiles * NC;
+			std::size_t rn = std::min(rows, R - r0), cn = std::min(NC, C - c0);
+			matrix_multiply(rn, K, cn, a + r0 * lda, lda, b + c0, ldb, c + r0 * ldc + c0, ldc);
+		}
+	});
+}
+
+#endif // CLASS_MATRIX_KERNEL
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "matrix.h"
+#include "../../number-theory/modint.h"
+#include <chrono>
+#include <iostream>
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+const uint32_t mod = 998244353;
+struct generic_modint {
+	// modint<mod> without the specializations of matrix-modint.h, which reduces every product (the former path)
+	modint<mod> v;
+	generic_modint() : v() {};
+	generic_modint(int64_t n) : v(n) {};
+	bool operator==(const generic_modint& m) const { return v == m.v; }
+	bool operator!=(const generic_modint& m) const { return v != m.v; }
+	generic_modint& operator+=(const generic_modint& m) { v += m.v; return *this; }
+	generic_modint& operator-=(const generic_modint& m) { v -= m.v; return *this; }
+	generic_modint& operator*=(const generic_modint& m) { v *= m.v; return *this; }
+	generic_modint operator-(const generic_modint& m) const { return generic_modint(*this) -= m; }
+	generic_modint operator*(const generic_modint& m) const { return generic_modint(*this) *= m; }
+	generic_modint operator/(const generic_modint& m) const { generic_modint ret(*this); ret.v *= m.v.inv(); return ret; }
+	uint32_t get() const { return v.get(); }
+};
+double seconds(chrono::system_clock::time_point start, chrono::system_clock::time_point finish) {
+	std::chrono::duration<double> duration = finish - start;
+	return duration.count();
+}
+template <class type>
+void run(const vector<uint32_t>& init, size_t n, uint64_t e, double& pow_time, double& det_time, uint32_t& pow_hash, uint32_t& det_value) {
+	matrix<type> a(n);
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			a.entry(i, j) = type(init[i * n + j]);
+		}
+	}
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	matrix<type> p = a.pow(e);
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	det_value = a.determinant().get();
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	pow_hash = 0;
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			pow_hash = pow_hash * 31 + p.entry(i, j).get();
+		}
+	}
+	pow_time = seconds(start, mid);
+	det_time = seconds(mid, finish);
+}
+void test(size_t n) {
+	const uint64_t e = 1000000000000000000ULL;
+	vector<uint32_t> init(n * n);
+	for(size_t i = 0; i < n * n; ++i) {
+		init[i] = xorshift32() % mod;
+	}
+	const char* names[3] = { "generic", "modint", "fast_modint" };
+	double pow_time[3], det_time[3];
+	uint32_t pow_hash[3], det_value[3];
+	run<generic_modint>(init, n, e, pow_time[0], det_time[0], pow_hash[0], det_value[0]);
+	run<modint<mod> >(init, n, e, pow_time[1], det_time[1], pow_hash[1], det_value[1]);
+	run<fast_modint<mod> >(init, n, e, pow_time[2], det_time[2], pow_hash[2], det_value[2]);
+	cout.precision(12);
+	cout << "---------- MODULAR TEST RESUTLTS (" << n << " * " << n << ", mod = " << mod << ", exponent = " << e << ") ----------" << endl;
+	for(int k = 0; k < 3; ++k) {
+		cout << fixed << names[k] << " pow: " << pow_time[k] << " seconds (" << pow_time[0] / pow_time[k] << "x, hash = " << pow_hash[k] << ")" << endl;
+		cout << fixed << names[k] << " determinant: " << det_time[k] << " seconds (" << det_time[0] / det_time[k] << "x, value = " << det_value[k] << ")" << endl;
+	}
+}
+int main() {
+	// Strassen-Winograd is turned off for modint and fast_modint, so that only the kernels are compared
+	matrix<modint<mod> >::use_strassen(0);
+	matrix<fast_modint<mod> >::use_strassen(0);
+	for(size_t n = 32; n <= 512; n *= 2) {
+		test(n);
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef CLASS_MATRIX_MODINT
+#define CLASS_MATRIX_MODINT
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+#include "matrix-kernel.h"
+#include "matrix-strassen.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// the specializations of matrix_kernel, matrix_scalar and matrix_strassen_default for modular types, such as modint and fast_modint
+// of number-theory/modint.h; they are chosen by the members below and not by name, so that matrix.h can include this header
+// (and every translation unit sees the same specializations) without depending on any modint header
+
+template <class type, class Enable = void>
+struct matrix_modular : std::false_type {};
+template <class type>
+struct matrix_modular<type, typename std::enable_if<(type::get_mod() < (std::uint32_t(1) << 31)) && sizeof(type) == sizeof(std::uint32_t)
+	&& std::is_same<decltype(std::declval<const type&>().get_raw()), std::uint32_t>::value && std::is_same<decltype(type::raw(std::uint32_t())), type>::value
+	&& std::is_same<decltype(std::declval<const type&>().get()), std::uint32_t>::value && std::is_same<decltype(std::declval<const type&>().inv()), type>::value>::type> : std::true_type {
+	// a constexpr get_mod() below 2^31 (as for the additions of modint), the stored 32-bit value by get_raw() and raw(), the plain value by get(),
+	// and inv(); the stored form f is the plain value or a Montgomery form (f(x) = x * 2^32 for fast_modint), whose product is f(x) * f(y) / f(1)
+};
+
+template <class type>
+struct modular_matrix_kernel {
+	// micro-kernel for modular types: the raw values (below mod < 2^31) are multiplied into 64-bit accumulators,
+	// which are reduced only once per k-block (KC products); each product is below 2^62, so it is enough to keep the accumulators
+	// below 2^63 by subtracting M (a multiple of mod^2) whenever they reach it, which is a compare and a subtraction and no division
+	// the sums are of stored values, f(x) * f(y) = f(x * y) * f(1), and the product of the type by raw(1) divides them by f(1) again:
+	// it is a no-op for plain values, and one Montgomery reduction per block for fast_modint
+	static const std::size_t MR = 4, NR = 8, MC = 128, KC = 256, NC = 1024;
+	static const std::uint64_t mod = type::get_mod();
+	static const std::uint64_t M = (std::uint64_t(1) << 63) / (mod * mod) * (mod * mod);
+	static void micro(std::size_t kc, const type* a, const type* b, type* c, std::size_t ldc, std::size_t mr, std::size_t nr) {
+		std::uint64_t acc[MR * NR] = {};
+		for (std::size_t k = 0; k < kc; ++k) {
+			for (std::size_t i = 0; i < MR; ++i) {
+				std::uint64_t x = a[k * MR + i].get_raw();
+				for (std::size_t j = 0; j < NR; ++j) {
+					std::uint64_t t = acc[i * NR + j] + x * b[k * NR + j].get_raw();
+					acc[i * NR + j] = (t >= M ? t - M : t);
+				}
+			}
+		}
+		for (std::size_t i = 0; i < mr; ++i) {
+			for (std::size_t j = 0; j < nr; ++j) {
+				type sum = type::raw(std::uint32_t(acc[i * NR + j] % mod));
+				sum *= type::raw(1);
+				c[i * ldc + j] += sum;
+			}
+		}
+	}
+};
+
+template <class type> struct matrix_kernel<type, typename std::enable_if<matrix_modular<type>::value>::type> : modular_matrix_kernel<type> {};
+// Strassen-Winograd is exact for them, and faster than the kernel alone above 256 (matrix-strassen.cpp)
+template <class type> struct matrix_strassen_default<type, typename std::enable_if<matrix_modular<type>::value>::type> { static const std::size_t crossover = 256; };
+
+template <class type>
+struct modular_matrix_scalar {
+	static_assert(sizeof(type) == sizeof(std::uint32_t), "the raw values are read as an array of 32-bit integers");
+	// modular inverse and row operation; mod must be less than 2^31 (as for the additions of modint)
+	static type inverse(const type& x) { return x.inv(); }
+	static void subtract_multiple(type* dst, const type* src, type mult, std::size_t len) {
+		// Shoup's multiplication by the fixed mult, with w' = floor(w * 2^32 / mod): x * w - floor(x * w' / 2^32) * mod is in [0, 2 * mod),
+		// so it is computed modulo 2^32 (mod < 2^31) and without any division, which the compiler can vectorize
+		// the stored values are multiplied by the plain value of mult, so that the products stay in the same form (f(x) * mult = f(x * mult))
+		const std::uint32_t mod = type::get_mod();
+		std::uint32_t w = mult.get();
+		std::uint32_t wp = std::uint32_t((std::uint64_t(w) << 32) / mod);
+		std::size_t k = 0;
+#ifdef __AVX2__
+		// 8 lanes at once; AVX2 has only the high products of even lanes, so odd lanes are shifted down; min_epu32 does the conditional subtractions
+		__m256i vw = _mm256_set1_epi32(int(w)), vwp = _mm256_set1_epi32(int(wp)), vmod = _mm256_set1_epi32(int(mod));
+		for (; k + 8 <= len; k += 8) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + k));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + k));
+			__m256i qe = _mm256_srli_epi64(_mm256_mul_epu32(x, vwp), 32);
+			__m256i qo = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), vwp);
+			__m256i q = _mm256_blend_epi32(qe, qo, 0xaa);
+			__m256i r = _mm256_sub_epi32(_mm256_mullo_epi32(x, vw), _mm256_mullo_epi32(q, vmod));
+			r = _mm256_min_epu32(r, _mm256_sub_epi32(r, vmod));
+			__m256i t = _mm256_sub_epi32(y, r);
+			t = _mm256_min_epu32(t, _mm256_add_epi32(t, vmod));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), t);
+		}
+#endif
+		for (; k < len; ++k) {
+			std::uint32_t x = src[k].get_raw(), y = dst[k].get_raw();
+			std::uint32_t r = x * w - std::uint32_t(std::uint64_t(x) * wp >> 32) * mod;
+			r -= (r >= mod ? mod : 0);
+			dst[k] = type::raw(y - r + (y < r ? mod : 0));
+		}
+	}
+};
+
+template <class type> struct matrix_scalar<type, typename std::enable_if<matrix_modular<type>::value>::type> : modular_matrix_scalar<type> {};
+
+#endif // CLASS_MATRIX_MODINT
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "matrix.h"
+#include <chrono>
+#include <thread>
+#include <iostream>
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+matrix<double> random_matrix(size_t n) {
+	// entries in [-1, 1] / n, so that the powers stay bounded
+	matrix<double> ret(n);
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			ret.entry(i, j) = (double(xorshift32() % 2001) - 1000.0) / 1000.0 / double(n);
+		}
+	}
+	return ret;
+}
+double seconds(chrono::system_clock::time_point start, chrono::system_clock::time_point finish) {
+	std::chrono::duration<double> duration = finish - start;
+	return duration.count();
+}
+void test(size_t n) {
+	// the same operations with no pool, and then with pools of 1, 2, 4, ... threads up to the number of hardware threads
+	matrix<double> a = random_matrix(n), b = random_matrix(n), p = random_matrix(n) + matrix<double>::unit(n);
+	size_t hardware = thread::hardware_concurrency();
+	if(hardware == 0) hardware = 1;
+	vector<size_t> threads(1, 0);
+	for(size_t t = 1; t < hardware; t *= 2) threads.push_back(t);
+	threads.push_back(hardware);
+	const char* names[3] = { "Multiplication", "Power (10)", "Inverse" };
+	double base[3] = { 0.0, 0.0, 0.0 };
+	matrix<double> expected[3];
+	cout.precision(12);
+	cout << "---------- PARALLEL TEST RESUTLTS (" << n << " * " << n << ", " << hardware << " hardware threads) ----------" << endl;
+	for(size_t i = 0; i < threads.size(); ++i) {
+		thread_pool pool(threads[i] == 0 ? 1 : threads[i]);
+		matrix<double>::use_thread_pool(threads[i] == 0 ? 0 : &pool);
+		matrix<double> c(a);
+		c *= b; // warming up the buffers
+		c = a;
+		chrono::system_clock::time_point t0 = chrono::system_clock::now();
+		c *= b;
+		chrono::system_clock::time_point t1 = chrono::system_clock::now();
+		matrix<double> q = p.pow(10);
+		chrono::system_clock::time_point t2 = chrono::system_clock::now();
+		matrix<double> inv = p.inverse();
+		chrono::system_clock::time_point t3 = chrono::system_clock::now();
+		double elapsed[3] = { seconds(t0, t1), seconds(t1, t2), seconds(t2, t3) };
+		matrix<double> result[3] = { c, q, inv };
+		if(i == 0) {
+			for(int k = 0; k < 3; ++k) base[k] = elapsed[k], expected[k] = result[k];
+		}
+		if(threads[i] == 0) cout << "No pool:" << endl;
+		else cout << threads[i] << " thread(s):" << endl;
+		for(int k = 0; k < 3; ++k) {
+			cout << fixed << "  " << names[k] << ": " << elapsed[k] << " seconds (" << base[k] / elapsed[k] << "x, " << (result[k] == expected[k] ? "same" : "different") << " result)" << endl;
+		}
+	}
+	matrix<double>::use_thread_pool(0);
+}
+int main() {
+	for(size_t n = 256; n <= 2048; n *= 2) {
+		test(n);
+	}
+	return 0;
+}
\ No newline at end of file
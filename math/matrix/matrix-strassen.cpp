@@ -0,0 +1,68 @@
+#include "matrix.h"
+#include "../../number-theory/modint.h"
+#include <cmath>
+#include <chrono>
+#include <iostream>
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+template <class type>
+double run(const matrix<type>& a, const matrix<type>& b, matrix<type>& c, size_t crossover) {
+	// the best of two runs (the first one also warms up the buffers)
+	double best = 1.0e18;
+	for(int t = 0; t < 2; ++t) {
+		chrono::system_clock::time_point start = chrono::system_clock::now();
+		matrix<type>::multiply(a, b, c, crossover);
+		chrono::system_clock::time_point finish = chrono::system_clock::now();
+		std::chrono::duration<double> duration = finish - start;
+		if(duration.count() < best) best = duration.count();
+	}
+	return best;
+}
+void test(size_t n) {
+	typedef modint<998244353> mint;
+	matrix<mint> a(n), b(n), c, d;
+	matrix<double> fa(n), fb(n), fc, fd;
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			a.entry(i, j) = mint(xorshift32());
+			b.entry(i, j) = mint(xorshift32());
+			fa.entry(i, j) = double(xorshift32() % 2001) / 1000.0 - 1.0;
+			fb.entry(i, j) = double(xorshift32() % 2001) / 1000.0 - 1.0;
+		}
+	}
+	double flops = 2.0 * n * n * n;
+	cout.precision(12);
+	cout << "---------- STRASSEN TEST RESUTLTS (" << n << " * " << n << ") ----------" << endl;
+	double base = run(a, b, c, 0);
+	cout << fixed << "modint, blocked: " << base << " seconds (" << flops / base * 1.0e-9 << " GFLOP/s)" << endl;
+	for(size_t crossover = 128; crossover <= 512; crossover *= 2) {
+		double duration = run(a, b, d, crossover);
+		cout << fixed << "modint, Strassen down to " << crossover << ": " << duration << " seconds (" << base / duration << "x, " << (c == d ? "same" : "different") << " result)" << endl;
+	}
+	double fbase = run(fa, fb, fc, 0);
+	cout << fixed << "double, blocked: " << fbase << " seconds (" << flops / fbase * 1.0e-9 << " GFLOP/s)" << endl;
+	for(size_t crossover = 256; crossover <= 1024; crossover *= 2) {
+		double duration = run(fa, fb, fd, crossover);
+		double error = 0.0;
+		for(size_t i = 0; i < n; ++i) {
+			for(size_t j = 0; j < n; ++j) {
+				error = max(error, fabs(fc.entry(i, j) - fd.entry(i, j)));
+			}
+		}
+		cout << fixed << "double, Strassen down to " << crossover << ": " << duration << " seconds (" << fbase / duration << "x, max difference " << error << ")" << endl;
+	}
+}
+int main() {
+	test(512);
+	test(1024);
+	test(1500);
+	test(2048);
+	test(3001);
+	return 0;
+}
\ No newline at end of file
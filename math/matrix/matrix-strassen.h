@@ -0,0 +1,107 @@
+#ifndef CLASS_MATRIX_STRASSEN
+#define CLASS_MATRIX_STRASSEN
+
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include "matrix-kernel.h"
+
+// Strassen-Winograd multiplication (7 products and 15 additions of half blocks per level) on top of matrix_multiply()
+// Each level multiplies the even part (R & ~1) * (K & ~1) * (C & ~1) recursively and peels the odd row, column and inner index off
+// (dynamic peeling), until one of the dimensions is at most crossover, where the blocked kernel is faster
+// It is exact for modint and integer types; with floating types the error grows by a small factor per level
+
+template <class type, class Enable = void>
+struct matrix_strassen_default {
+	// the crossover of the products of matrix<type> until use_strassen() sets another one; 0 (off) unless specialized,
+	// since Strassen-Winograd needs subtraction (no semirings), may overflow signed intermediates where the plain product does not,
+	// and changes the rounding of floating types; matrix-modint.h turns it on for modular types such as modint and fast_modint
+	static const std::size_t crossover = 0;
+};
+
+template <class type, class Enable = void>
+struct matrix_strassen_ops : std::false_type {};
+template <class type>
+struct matrix_strassen_ops<type, decltype(void(std::declval<const type&>() + std::declval<const type&>()), void(std::declval<const type&>() - std::declval<const type&>()))> : std::true_type {
+	// types with binary + and -, which matrix_multiply_strassen() needs; matrix<type> never instantiates it for the others
+};
+
+inline std::size_t strassen_workspace_size(std::size_t R, std::size_t K, std::size_t C, std::size_t crossover) {
+	// the number of elements of workspace needed by matrix_multiply_strassen(): three half blocks for each level
+	std::size_t ans = 0;
+	while (R > crossover && K > crossover && C > crossover && R >= 2 && K >= 2 && C >= 2) {
+		R /= 2; K /= 2; C /= 2;
+		ans += R * K + K * C + R * C;
+	}
+	return ans;
+}
+
+template <class type>
+void strassen_combine(std::size_t R, std::size_t C, const type* a, std::size_t lda, const type* b, std::size_t ldb, type* c, std::size_t ldc, bool subtract) {
+	// c = a + b (or a - b); c may be the same block as a or b
+	for (std::size_t i = 0; i < R; ++i) {
+		const type* x = a + i * lda;
+		const type* y = b + i * ldb;
+		type* z = c + i * ldc;
+		if (subtract) for (std::size_t j = 0; j < C; ++j) z[j] = x[j] - y[j];
+		else for (std::size_t j = 0; j < C; ++j) z[j] = x[j] + y[j];
+	}
+}
+
+template <class type>
+void strassen_leaf(std::size_t R, std::size_t K, std::size_t C, const type* a, std::size_t lda, const type* b, std::size_t ldb, type* c, std::size_t ldc, thread_pool* pool) {
+	if (pool != 0) matrix_multiply(R, K, C, a, lda, b, ldb, c, ldc, *pool);
+	else matrix_multiply(R, K, C, a, lda, b, ldb, c, ldc);
+}
+
+template <class type>
+void matrix_multiply_strassen(std::size_t R, std::size_t K, std::size_t C, const type* a, std::size_t lda, const type* b, std::size_t ldb, type* c, std::size_t ldc,
+	std::size_t crossover, type* workspace, thread_pool* pool = 0) {
+	// c = a * b as matrix_multiply(), with workspace of at least strassen_workspace_size(R, K, C, crossover) elements;
+	// the products at the bottom use pool when it is not null
+	if (R <= crossover || K <= crossover || C <= crossover || R < 2 || K < 2 || C < 2) {
+		strassen_leaf(R, K, C, a, lda, b, ldb, c, ldc, pool);
+		return;
+	}
+	const std::size_t r = R / 2, k = K / 2, n = C / 2;
+	const type *a11 = a, *a12 = a + k, *a21 = a + r * lda, *a22 = a + r * lda + k;
+	const type *b11 = b, *b12 = b + n, *b21 = b + k * ldb, *b22 = b + k * ldb + n;
+	type *c11 = c, *c12 = c + n, *c21 = c + r * ldc, *c22 = c + r * ldc + n;
+	type *x = workspace, *y = x + r * k, *z = y + k * n, *next = z + r * n;
+	// the schedule of Douglas et al. (DGEFMM), with the temporaries x (r * k), y (k * n) and z (r * n)
+	strassen_combine(r, k, a11, lda, a21, lda, x, k, true); // S3 = A11 - A21
+	strassen_combine(k, n, b22, ldb, b12, ldb, y, n, true); // T3 = B22 - B12
+	matrix_multiply_strassen(r, k, n, x, k, y, n, c21, ldc, crossover, next, pool); // P7 = S3 * T3
+	strassen_combine(r, k, a21, lda, a22, lda, x, k, false); // S1 = A21 + A22
+	strassen_combine(k, n, b12, ldb, b11, ldb, y, n, true); // T1 = B12 - B11
+	matrix_multiply_strassen(r, k, n, x, k, y, n, c22, ldc, crossover, next, pool); // P5 = S1 * T1
+	strassen_combine(r, k, x, k, a11, lda, x, k, true); // S2 = S1 - A11
+	strassen_combine(k, n, b22, ldb, y, n, y, n, true); // T2 = B22 - T1
+	matrix_multiply_strassen(r, k, n, x, k, y, n, c12, ldc, crossover, next, pool); // P6 = S2 * T2
+	strassen_combine(r, k, a12, lda, x, k, x, k, true); // S4 = A12 - S2
+	matrix_multiply_strassen(r, k, n, x, k, b22, ldb, c11, ldc, crossover, next, pool); // P3 = S4 * B22
+	matrix_multiply_strassen(r, k, n, a11, lda, b11, ldb, z, n, crossover, next, pool); // P1 = A11 * B11
+	strassen_combine(r, n, z, n, c12, ldc, c12, ldc, false); // U2 = P1 + P6
+	strassen_combine(r, n, c12, ldc, c21, ldc, c21, ldc, false); // U3 = U2 + P7
+	strassen_combine(r, n, c12, ldc, c22, ldc, c12, ldc, false); // U4 = U2 + P5
+	strassen_combine(r, n, c21, ldc, c22, ldc, c22, ldc, false); // C22 = U3 + P5
+	strassen_combine(r, n, c12, ldc, c11, ldc, c12, ldc, false); // C12 = U4 + P3
+	strassen_combine(k, n, y, n, b21, ldb, y, n, true); // T4 = T2 - B21
+	matrix_multiply_strassen(r, k, n, a22, lda, y, n, c11, ldc, crossover, next, pool); // P4 = A22 * T4
+	strassen_combine(r, n, c21, ldc, c11, ldc, c21, ldc, true); // C21 = U3 - P4
+	matrix_multiply_strassen(r, k, n, a12, lda, b21, ldb, c11, ldc, crossover, next, pool); // P2 = A12 * B21
+	strassen_combine(r, n, z, n, c11, ldc, c11, ldc, false); // C11 = P1 + P2
+	// peeling: the last inner index (rank-1 update of the even part), then the last column and the last row in full
+	if (K % 2 == 1) {
+		for (std::size_t i = 0; i < 2 * r; ++i) {
+			type s = a[i * lda + K - 1];
+			const type* v = b + (K - 1) * ldb;
+			type* w = c + i * ldc;
+			for (std::size_t j = 0; j < 2 * n; ++j) w[j] += s * v[j];
+		}
+	}
+	if (C % 2 == 1) strassen_leaf(R, K, std::size_t(1), a, lda, b + C - 1, ldb, c + C - 1, ldc, pool);
+	if (R % 2 == 1) strassen_leaf(std::size_t(1), K, 2 * n, a + (R - 1) * lda, lda, b, ldb, c + (R - 1) * ldc, ldc, pool);
+}
+
+#endif // CLASS_MATRIX_STRASSEN
\ No newline at end of file
@@ -1,6 +1,57 @@
 #include "matrix.h"
+#include <chrono>
 #include <iostream>
 using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+template <class type>
+matrix<type> naive_multiply(const matrix<type>& a, const matrix<type>& b, size_t n) {
+	// the former operator*=: transposed right operand and dot products
+	matrix<type> tb = b.transpose(), ret(n);
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			type sum = type(0);
+			for(size_t k = 0; k < n; ++k) {
+				sum += a.entry(i, k) * tb.entry(j, k);
+			}
+			ret.entry(i, j) = sum;
+		}
+	}
+	return ret;
+}
+template <class type>
+void test(const char* name, size_t n, bool compare) {
+	matrix<type> a(n), b(n);
+	for(size_t i = 0; i < n; ++i) {
+		for(size_t j = 0; j < n; ++j) {
+			a.entry(i, j) = type(xorshift32() % 201) - type(100);
+			b.entry(i, j) = type(xorshift32() % 201) - type(100);
+		}
+	}
+	matrix<type> c(a);
+	c *= b; // warming up the buffers
+	c = a;
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	c *= b;
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	double flops = 2.0 * n * n * n;
+	std::chrono::duration<double> duration = finish - start;
+	cout.precision(12);
+	cout << "---------- GEMM TEST RESUTLTS (" << name << ", " << n << " * " << n << ") ----------" << endl;
+	cout << fixed << "Blocked: " << duration.count() << " seconds (" << flops / duration.count() * 1.0e-9 << " GFLOP/s)" << endl;
+	if(compare) {
+		start = chrono::system_clock::now();
+		matrix<type> d = naive_multiply(a, b, n);
+		finish = chrono::system_clock::now();
+		duration = finish - start;
+		cout << fixed << "Naive: " << duration.count() << " seconds (" << flops / duration.count() * 1.0e-9 << " GFLOP/s, " << (c == d ? "same" : "different") << " result)" << endl;
+	}
+}
 int main() {
 	matrix<double> d(2), I = matrix<double>::unit(2);
 	d.entry(0, 0) = 2.0; d.entry(0, 1) = -1.0;
@@ -8,5 +59,9 @@ int main() {
 	for(int i = -10; i <= 10; ++i) {
 		cout << i << ' ' << (d - I * 4 - I * i).determinant() << endl;
 	}
+	for(size_t n = 512; n <= 4096; n *= 2) {
+		test<double>("double", n, n <= 1024);
+		test<long long>("long long", n, n <= 1024);
+	}
 	return 0;
 }
\ No newline at end of file
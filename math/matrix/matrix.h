@@ -1,24 +1,124 @@
 #ifndef CLASS_MATRIX
 #define CLASS_MATRIX
 
+#include <cmath>
 #include <vector>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <utility>
+#include <type_traits>
+#include "matrix-kernel.h"
+#include "matrix-modint.h"
+#include "matrix-strassen.h"
+#include "matrix-expression.h"
+
+template <class type, bool floating = std::is_floating_point<type>::value>
+struct matrix_pivot {
+	// the choice of the pivot in a column: the first nonzero entry for exact (field) types
+	static bool better(const type& candidate, const type& current) { return current == type(0) && candidate != type(0); }
+};
+template <class type>
+struct matrix_pivot<type, true> {
+	// and the entry of the largest magnitude (partial pivoting) for floating types, which keeps the multipliers at most 1
+	static bool better(const type& candidate, const type& current) { return std::abs(candidate) > std::abs(current); }
+};
 
 template<class type>
-class matrix {
+class matrix : public matrix_expression<matrix<type>, type> {
 private:
 	std::size_t R, C;
 	std::vector<type> val;
+	static thread_pool*& pool() {
+		static thread_pool* ptr = 0;
+		return ptr;
+	}
+	static const std::size_t parallel_threshold = std::size_t(1) << 21; // multiply-adds (or updated entries) to use the pool
+	static std::size_t& strassen_crossover() {
+		static std::size_t crossover = matrix_strassen_default<type>::crossover;
+		return crossover;
+	}
+	static bool multiply_strassen(std::size_t R, std::size_t K, std::size_t C, const type* a, const type* b, type* c, std::size_t crossover, thread_pool* parallel, std::true_type) {
+		// the workspace of Strassen-Winograd is per thread and kept between calls
+		static thread_local std::vector<type> workspace;
+		std::size_t size = strassen_workspace_size(R, K, C, crossover);
+		if (workspace.size() < size) workspace.resize(size);
+		matrix_multiply_strassen(R, K, C, a, K, b, C, c, C, crossover, workspace.data(), parallel);
+		return true;
+	}
+	static bool multiply_strassen(std::size_t, std::size_t, std::size_t, const type*, const type*, type*, std::size_t, thread_pool*, std::false_type) {
+		// no binary + and -, so the blocked kernel is used
+		return false;
+	}
+	static void multiply(std::size_t R, std::size_t K, std::size_t C, const type* a, const type* b, type* c, std::size_t crossover) {
+		// crossover = 0 is the blocked kernel only
+		thread_pool* parallel = (pool() != 0 && R * K * C >= parallel_threshold ? pool() : 0);
+		if (crossover != 0 && R > crossover && K > crossover && C > crossover && multiply_strassen(R, K, C, a, b, c, crossover, parallel, matrix_strassen_ops<type>())) return;
+		if (parallel != 0) matrix_multiply(R, K, C, a, K, b, C, c, C, *parallel);
+		else matrix_multiply(R, K, C, a, K, b, C, c, C);
+	}
+	type eliminate_determinant() {
+		// determinant by elimination in place
+		assert(R == C);
+		type ans = type(1);
+		for(std::size_t i = 0; i < R; ++i) {
+			std::size_t pos = i;
+			for(std::size_t j = i + 1; j < R; ++j) {
+				if(matrix_pivot<type>::better(val[j * C + i], val[pos * C + i])) pos = j;
+			}
+			if(val[pos * C + i] == type(0)) return type(0);
+			if(pos != i) {
+				ans = type(0) - ans;
+				for(std::size_t j = i; j < C; ++j) {
+					std::swap(val[i * C + j], val[pos * C + j]);
+				}
+			}
+			ans *= val[i * C + i];
+			type pivot_inv = matrix_scalar<type>::inverse(val[i * C + i]);
+			for(std::size_t j = i + 1; j < R; ++j) {
+				type mul = val[j * C + i] * pivot_inv;
+				matrix_scalar<type>::subtract_multiple(val.data() + j * C + i + 1, val.data() + i * C + i + 1, mul, C - i - 1);
+			}
+		}
+		return ans;
+	}
 public:
 	matrix() : R(0), C(0), val(std::vector<type>()) {};
 	matrix(std::size_t R_, std::size_t C_) : R(R_), C(C_), val(std::vector<type>(R* C)) {}
 	matrix(std::size_t N_) : R(N_), C(N_), val(std::vector<type>(N_* N_)) {}
+	template <class E>
+	matrix(const matrix_expression<E, type>& expr) : R(expr.rows()), C(expr.cols()) {
+		// evaluates the expression in one pass
+		val.reserve(R * C);
+		for (std::size_t i = 0; i < R * C; ++i) val.push_back(expr.element(i));
+	}
+	template <class E>
+	matrix& operator=(const matrix_expression<E, type>& expr) {
+		// the expression may contain this matrix, which is fine since each element depends only on the same element of the operands
+		std::size_t R_ = expr.rows(), C_ = expr.cols();
+		val.resize(R_ * C_);
+		for (std::size_t i = 0; i < R_ * C_; ++i) val[i] = expr.element(i);
+		R = R_; C = C_;
+		return *this;
+	}
+	static void use_thread_pool(thread_pool* pool_) {
+		// opt-in for operator*=, pow() and gaussian_elimination() of all matrices of this type; null turns it off again
+		// it is not synchronized, so it should be set before the matrices are used by the other threads
+		pool() = pool_;
+	}
+	static void use_strassen(std::size_t crossover) {
+		// products of matrices of this type whose three sizes are all above crossover use Strassen-Winograd; 0 turns it off
+		// it is off by default except for modular types such as modint and fast_modint (matrix_strassen_default), and type must have binary + and -
+		// it is not synchronized, in the same way as use_thread_pool()
+		assert(crossover == 0 || matrix_strassen_ops<type>::value);
+		strassen_crossover() = crossover;
+	}
+	std::size_t rows() const { return R; }
+	std::size_t cols() const { return C; }
+	type element(std::size_t i) const { return val[i]; }
 	type& entry(std::size_t r, std::size_t c) { return val[r * C + c]; }
 	type entry(std::size_t r, std::size_t c) const { return val[r * C + c]; }
-	static const matrix unit(std::size_t N) {
+	static matrix unit(std::size_t N) {
 		matrix ret(N);
 		for (std::size_t i = 0; i < N; ++i) {
 			ret.entry(i, i) = type(1);
@@ -48,49 +148,67 @@ public:
 		}
 		return false;
 	}
-	matrix& operator+=(const matrix& mat) {
-		assert(R == mat.R && C == mat.C);
-		for (std::size_t i = 0; i < R * C; ++i) val[i] += mat.val[i];
+	template <class E>
+	matrix& operator+=(const matrix_expression<E, type>& expr) {
+		assert(R == expr.rows() && C == expr.cols());
+		for (std::size_t i = 0; i < R * C; ++i) val[i] += expr.element(i);
 		return *this;
 	}
-	matrix& operator-=(const matrix& mat) {
-		assert(R == mat.R && C == mat.C);
-		for (std::size_t i = 0; i < R * C; ++i) val[i] -= mat.val[i];
+	template <class E>
+	matrix& operator-=(const matrix_expression<E, type>& expr) {
+		assert(R == expr.rows() && C == expr.cols());
+		for (std::size_t i = 0; i < R * C; ++i) val[i] -= expr.element(i);
 		return *this;
 	}
-	matrix& operator*=(const matrix& mat) {
+	// the products are templates which take only matrices, so that a scalar is never converted by matrix(std::size_t):
+	// I * 4 and m *= 4 are the scalar products (by the expression operators and operator*=(const type&)) for every type
+	template <class M, class = typename std::enable_if<std::is_same<M, matrix>::value>::type>
+	matrix& operator*=(const M& mat) {
+		// blocked multiplication into a per-thread buffer, which is swapped with val; the old val is the buffer of the next call
 		assert(C == mat.R);
-		matrix tmat = mat.transpose();
-		std::vector<type> tmp(R * tmat.R);
-		for (std::size_t i = 0; i < R; ++i) {
-			for (std::size_t j = 0; j < tmat.R; ++j) {
-				for (std::size_t k = 0; k < C; ++k) {
-					tmp[i * tmat.R + j] += val[i * C + k] * tmat.val[j * tmat.C + k];
-				}
-			}
-		}
-		C = tmat.R;
-		val = tmp;
+		static thread_local std::vector<type> buffer;
+		buffer.resize(R * mat.C);
+		multiply(R, C, mat.C, val.data(), mat.val.data(), buffer.data(), strassen_crossover());
+		C = mat.C;
+		val.swap(buffer);
 		return *this;
 	}
-	matrix operator+=(const type& x) {
+	matrix& operator+=(const type& x) {
 		for (std::size_t i = 0; i < R * C; ++i) val[i] += x;
 		return *this;
 	}
-	matrix operator-=(const type& x) {
+	matrix& operator-=(const type& x) {
 		for (std::size_t i = 0; i < R * C; ++i) val[i] -= x;
 		return *this;
 	}
-	matrix operator*=(const type& x) {
+	matrix& operator*=(const type& x) {
 		for (std::size_t i = 0; i < R * C; ++i) val[i] *= x;
 		return *this;
 	}
-	matrix operator+(const matrix& mat) const { return matrix(*this) += mat; }
-	matrix operator-(const matrix& mat) const { return matrix(*this) -= mat; }
-	matrix operator*(const matrix& mat) const { return matrix(*this) *= mat; }
-	matrix operator+(const type& x) const { return matrix(*this) += x; }
-	matrix operator-(const type& x) const { return matrix(*this) -= x; }
-	matrix operator*(const type& x) const { return matrix(*this) *= x; }
+	// the element-wise operators (+, - and the scalar ones) are lazy expressions (matrix-expression.h)
+	template <class M, class = typename std::enable_if<std::is_same<M, matrix>::value>::type>
+	matrix operator*(const M& mat) const& {
+		matrix ret;
+		multiply(*this, mat, ret);
+		return ret;
+	}
+	template <class M, class = typename std::enable_if<std::is_same<M, matrix>::value>::type>
+	matrix operator*(const M& mat) && {
+		// the storage of a temporary left operand is reused
+		*this *= mat;
+		return std::move(*this);
+	}
+	static void multiply(const matrix& a, const matrix& b, matrix& out) { multiply(a, b, out, strassen_crossover()); }
+	static void multiply(const matrix& a, const matrix& b, matrix& out, std::size_t crossover) {
+		// out = a * b, in the storage of out (which must not be a or b), so that it allocates nothing when out is already large enough
+		// crossover selects the method for this call: 0 for the blocked kernel, and otherwise Strassen-Winograd down to that size
+		// (which needs binary + and -, as in use_strassen())
+		assert(a.C == b.R && &out != &a && &out != &b);
+		assert(crossover == 0 || matrix_strassen_ops<type>::value);
+		out.R = a.R; out.C = b.C;
+		out.val.resize(a.R * b.C);
+		multiply(a.R, a.C, b.C, a.val.data(), b.val.data(), out.val.data(), crossover);
+	}
 	matrix pow(std::uint64_t b) const {
 		assert(R == C);
 		matrix ans = unit(R), cur(*this);
@@ -107,72 +225,49 @@ public:
 		std::size_t curpos = 0;
 		for (std::size_t i = 0; i < R; ++i) {
 			while (curpos < C) {
-				std::size_t pos = std::size_t(-1);
-				for (std::size_t j = i; j < R; ++j) {
-					if (lmat.val[j * C + curpos] != type(0)) {
-						pos = j;
-						if (j != i) {
-							for (std::size_t k = 0; k < C; ++k) std::swap(lmat.val[i * C + k], lmat.val[j * C + k]);
-							for (std::size_t k = 0; k < rmat.C; ++k) std::swap(rmat.val[i * rmat.C + k], rmat.val[j * rmat.C + k]);
-						}
-						break;
-					}
+				std::size_t pos = i;
+				for (std::size_t j = i + 1; j < R; ++j) {
+					if (matrix_pivot<type>::better(lmat.val[j * C + curpos], lmat.val[pos * C + curpos])) pos = j;
 				}
-				if (pos != std::size_t(-1)) {
-					type mult = type(1) / lmat.val[i * C + curpos];
+				if (lmat.val[pos * C + curpos] != type(0)) {
+					if (pos != i) {
+						for (std::size_t k = 0; k < C; ++k) std::swap(lmat.val[i * C + k], lmat.val[pos * C + k]);
+						for (std::size_t k = 0; k < rmat.C; ++k) std::swap(rmat.val[i * rmat.C + k], rmat.val[pos * rmat.C + k]);
+					}
+					type mult = matrix_scalar<type>::inverse(lmat.val[i * C + curpos]);
 					for (std::size_t j = 0; j < C; ++j) lmat.val[i * C + j] *= mult;
 					for (std::size_t j = 0; j < rmat.C; ++j) rmat.val[i * rmat.C + j] *= mult;
 					lmat.val[i * C + curpos] = type(1);
-					for (std::size_t j = 0; j < R; ++j) {
-						if (j == i || lmat.val[j * C + curpos] == type(0)) continue;
-						type submult = lmat.val[j * C + curpos];
-						for (std::size_t k = 0; k < C; ++k) lmat.val[j * C + k] -= lmat.val[i * C + k] * submult;
-						for (std::size_t k = 0; k < rmat.C; ++k) rmat.val[j * rmat.C + k] -= rmat.val[i * rmat.C + k] * submult;
-						lmat.val[j * C + curpos] = type(0);
-					}
+					// the other rows are independent of each other, so they are split among the pool when it is large enough
+					auto eliminate = [&](std::size_t first, std::size_t last) {
+						for (std::size_t j = first; j < last; ++j) {
+							if (j == i || lmat.val[j * C + curpos] == type(0)) continue;
+							type submult = lmat.val[j * C + curpos];
+							matrix_scalar<type>::subtract_multiple(lmat.val.data() + j * C, lmat.val.data() + i * C, submult, C);
+							matrix_scalar<type>::subtract_multiple(rmat.val.data() + j * rmat.C, rmat.val.data() + i * rmat.C, submult, rmat.C);
+							lmat.val[j * C + curpos] = type(0);
+						}
+					};
+					if (pool() != 0 && R * (C + rmat.C) >= parallel_threshold) pool()->parallel_for(0, R, (R + 4 * pool()->size() - 1) / (4 * pool()->size()), eliminate);
+					else eliminate(0, R);
 					break;
 				}
 				++curpos;
 			}
 			if (curpos == C) break;
 		}
-		return std::make_pair(lmat, rmat);
+		return std::make_pair(std::move(lmat), std::move(rmat));
 	}
 	matrix inverse() const {
 		assert(R == C);
+		// singular if the reduced form is not the identity, which is when its last diagonal entry is zero
+		// repeated inversions or solves of the same matrix should use lu_decomposition (lu-decomposition.h) instead
 		std::pair<matrix, matrix> res = gaussian_elimination(unit(R));
-		if (res.first != unit(R)) return matrix();
-		return res.second;
-	}
-	type determinant() const {
-		assert(R == C);
-		matrix mat(*this);
-		type ans = type(1);
-		for(std::size_t i = 0; i < R; ++i) {
-			std::size_t pos = std::size_t(-1);
-			for(std::size_t j = i; j < R; ++j) {
-				if(mat.val[j * C + i] != type(0)) {
-					pos = j;
-					break;
-				}
-			}
-			if(pos == std::size_t(-1)) return type(0);
-			if(pos != i) {
-				ans *= type(-1);
-				for(std::size_t j = i; j < C; ++j) {
-					std::swap(mat.val[i * C + j], mat.val[pos * C + j]);
-				}
-			}
-			ans *= mat.val[i * C + i];
-			for(std::size_t j = i + 1; j < R; ++j) {
-				type mul = mat.val[j * C + i] / mat.val[i * C + i];
-				for(std::size_t k = i + 1; k < C; ++k) {
-					mat.val[j * C + k] -= mat.val[i * C + k] * mul;
-				}
-			}
-		}
-		return ans;
+		if (R != 0 && res.first.val[R * C - 1] == type(0)) return matrix();
+		return std::move(res.second);
 	}
+	type determinant() const& { return matrix(*this).eliminate_determinant(); }
+	type determinant() && { return eliminate_determinant(); }
 };
 
 #endif // CLASS_MATRIX
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef CLASS_THREAD_POOL
+#define CLASS_THREAD_POOL
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+class thread_pool {
+	// Work-stealing thread pool: each worker has its own deque, pops from the back of it, and steals from the front of the others
+	// parallel_for() blocks until all of its chunks are done, and the calling thread runs chunks too, so it may be nested
+private:
+	struct task_queue {
+		std::mutex mtx;
+		std::deque<std::function<void()> > tasks;
+	};
+	std::vector<std::unique_ptr<task_queue> > queues;
+	std::vector<std::thread> workers;
+	std::atomic<std::size_t> queued, next_queue;
+	std::atomic<bool> stopping;
+	std::mutex sleep_mtx;
+	std::condition_variable wakeup;
+	static std::size_t& worker_index() {
+		// index of the queue of this thread (the number of queues for threads which are not workers)
+		static thread_local std::size_t index = std::size_t(-1);
+		return index;
+	}
+	bool try_pop(std::size_t self, std::function<void()>& task) {
+		std::size_t k = queues.size();
+		for (std::size_t d = 0; d < k; ++d) {
+			std::size_t i = (self + d) % k;
+			std::lock_guard<std::mutex> lock(queues[i]->mtx);
+			if (queues[i]->tasks.empty()) continue;
+			if (d == 0 && self < k) task = std::move(queues[i]->tasks.back()), queues[i]->tasks.pop_back();
+			else task = std::move(queues[i]->tasks.front()), queues[i]->tasks.pop_front();
+			--queued;
+			return true;
+		}
+		return false;
+	}
+	void run_worker(std::size_t id) {
+		worker_index() = id;
+		std::function<void()> task;
+		while (true) {
+			if (try_pop(id, task)) {
+				task();
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(sleep_mtx);
+			wakeup.wait(lock, [&]() { return stopping.load() || queued.load() != 0; });
+			if (stopping.load() && queued.load() == 0) return;
+		}
+	}
+	void push(std::function<void()> task) {
+		// counted before it is visible, so that queued never goes below zero; a worker woken early only looks once more
+		std::size_t self = worker_index();
+		std::size_t i = (self < queues.size() ? self : next_queue++ % queues.size());
+		{
+			std::lock_guard<std::mutex> lock(sleep_mtx);
+			++queued;
+		}
+		{
+			std::lock_guard<std::mutex> lock(queues[i]->mtx);
+			queues[i]->tasks.push_back(std::move(task));
+		}
+		wakeup.notify_one();
+	}
+	thread_pool(const thread_pool&);
+	thread_pool& operator=(const thread_pool&);
+public:
+	explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency()) : queued(0), next_queue(0), stopping(false) {
+		// threads - 1 workers, since the thread calling parallel_for() works as well
+		if (threads == 0) threads = 1;
+		for (std::size_t i = 0; i + 1 < threads; ++i) queues.push_back(std::unique_ptr<task_queue>(new task_queue()));
+		if (queues.empty()) queues.push_back(std::unique_ptr<task_queue>(new task_queue()));
+		for (std::size_t i = 0; i + 1 < threads; ++i) workers.push_back(std::thread(&thread_pool::run_worker, this, i));
+	}
+	~thread_pool() {
+		{
+			std::lock_guard<std::mutex> lock(sleep_mtx);
+			stopping = true;
+		}
+		wakeup.notify_all();
+		for (std::size_t i = 0; i < workers.size(); ++i) workers[i].join();
+	}
+	std::size_t size() const { return workers.size() + 1; }
+	template <class Function>
+	void parallel_for(std::size_t first, std::size_t last, std::size_t grain, Function func) {
+		// calls func(l, r) for chunks [l, r) of [first, last), each of at most grain (at least 1) indices
+		if (grain == 0) grain = 1;
+		if (last <= first) return;
+		std::size_t chunks = (last - first + grain - 1) / grain;
+		if (chunks == 1 || workers.empty()) {
+			func(first, last);
+			return;
+		}
+		std::atomic<std::size_t> remaining(chunks - 1);
+		for (std::size_t c = 1; c < chunks; ++c) {
+			std::size_t l = first + c * grain, r = (last - l < grain ? last : l + grain);
+			push([&func, &remaining, l, r]() { func(l, r); --remaining; });
+		}
+		func(first, first + grain);
+		// helps the others (or runs the own chunks) until all of them are done
+		std::size_t self = worker_index();
+		std::function<void()> task;
+		while (remaining.load() != 0) {
+			if (try_pop(self < queues.size() ? self : queues.size(), task)) task();
+			else std::this_thread::yield();
+		}
+	}
+	static thread_pool& shared() {
+		// one pool with the number of hardware threads, created on first use
+		static thread_pool pool;
+		return pool;
+	}
+};
+
+#endif // CLASS_THREAD_POOL
\ No newline at end of file
@@ -12,6 +12,8 @@ public:
 	modint(std::int64_t n_) : n((n_ >= 0 ? n_ : mod - (-n_) % mod) % mod) {};
 	static constexpr std::uint32_t get_mod() { return mod; }
 	std::uint32_t get() const { return n; }
+	std::uint32_t get_raw() const { return n; }
+	static modint raw(std::uint32_t n_) { modint ret; ret.n = n_; return ret; }
 	bool operator==(const modint& m) const { return n == m.n; }
 	bool operator!=(const modint& m) const { return n != m.n; }
 	modint& operator+=(const modint& m) { n += m.n; n = (n < mod ? n : n - mod); return *this; }
@@ -58,6 +60,8 @@ public:
 	fast_modint(std::uint32_t n_) { n = reduce(std::uint64_t(n_) * r2); };
 	static constexpr std::uint32_t get_mod() { return mod; }
 	std::uint32_t get() const { return reduce(n); }
+	std::uint32_t get_raw() const { return n; } // in Montgomery form, (value * 2^32) % mod
+	static fast_modint raw(std::uint32_t n_) { fast_modint ret; ret.n = n_; return ret; }
 	bool operator==(const fast_modint& x) const { return n == x.n; }
 	bool operator!=(const fast_modint& x) const { return n != x.n; }
 	fast_modint& operator+=(const fast_modint& x) { n += x.n; n -= (n < mod ? 0 : mod); return *this; }
@@ -99,6 +103,8 @@ public:
 	Very Basic Function:
 	- uint32_t get_mod() : Returns the modulo value
 	- uint32_t get() : Returns the value converted to integer type
+	- uint32_t get_raw() : Returns the stored value (the same as get() for modint, and the Montgomery form for fast_modint)
+	- modint raw(uint32_t n) : Returns the modint whose stored value is n (which must be less than mod)
 
 	Operators:
 	- bool operator==(const modint& m) : Returns true if equal, otherwise false
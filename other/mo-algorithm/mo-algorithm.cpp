@@ -0,0 +1,132 @@
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include "mo-algorithm.h"
+using namespace std;
+unsigned x = 123456789;
+unsigned xorshift32() {
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+void test(int n, int q) {
+	// the number of distinct values in [l, r), with mo_scheduler and with the classic order of blocks of size n / sqrt(q)
+	vector<int> a(n), ql(q), qr(q);
+	for(int i = 0; i < n; ++i) {
+		a[i] = xorshift32() % n;
+	}
+	for(int i = 0; i < q; ++i) {
+		ql[i] = xorshift32() % n; qr[i] = xorshift32() % n;
+		if(ql[i] > qr[i]) std::swap(ql[i], qr[i]);
+		++qr[i];
+	}
+	vector<int> cnt(n);
+	int distinct = 0;
+	auto add = [&](size_t i) { distinct += (cnt[a[i]]++ == 0); };
+	auto remove = [&](size_t i) { distinct -= (--cnt[a[i]] == 0); };
+	vector<int> res(q);
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	mo_scheduler mo(n);
+	for(int i = 0; i < q; ++i) {
+		mo.add_query(ql[i], qr[i]);
+	}
+	mo.run(add, add, remove, remove, [&](size_t k) { res[k] = distinct; });
+	chrono::system_clock::time_point mid = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < q; ++i) {
+		sum += res[i];
+	}
+	// classic order: (block of l, r), with r alternating in odd blocks
+	int b = max(1, int(n / sqrt(double(q))));
+	vector<int> order(q);
+	for(int i = 0; i < q; ++i) {
+		order[i] = i;
+	}
+	sort(order.begin(), order.end(), [&](int i, int j) {
+		if(ql[i] / b != ql[j] / b) return ql[i] / b < ql[j] / b;
+		return (ql[i] / b) & 1 ? qr[i] > qr[j] : qr[i] < qr[j];
+	});
+	cnt.assign(n, 0);
+	distinct = 0;
+	long long travel = 0, sum2 = 0;
+	int l = 0, r = 0;
+	for(int j = 0; j < q; ++j) {
+		int k = order[j];
+		travel += abs(l - ql[k]) + abs(r - qr[k]);
+		while(l > ql[k]) add(--l);
+		while(r < qr[k]) add(r++);
+		while(l < ql[k]) remove(l++);
+		while(r > qr[k]) remove(--r);
+		sum2 += distinct;
+	}
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	cout.precision(12);
+	std::chrono::duration<double> hilbert_duration = mid - start;
+	std::chrono::duration<double> block_duration = finish - mid;
+	cout << "---------- TEST RESUTLTS (# of Elements = " << n << ", # of Queries = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << ' ' << sum2 << endl;
+	cout << fixed << "Hilbert Order: " << hilbert_duration.count() << " seconds (" << hilbert_duration.count() / q << " seconds per query, pointer travel = " << mo.pointer_travel() << ")" << endl;
+	cout << fixed << "Block Order: " << block_duration.count() << " seconds (" << block_duration.count() / q << " seconds per query, pointer travel = " << travel << ")" << endl;
+}
+void test_update(int n, int q) {
+	// the number of distinct values in [l, r), with point assignments between the queries (half of the operations)
+	vector<int> a(n);
+	for(int i = 0; i < n; ++i) {
+		a[i] = xorshift32() % n;
+	}
+	mo_update_scheduler mo(n);
+	vector<int> upos, uval;
+	for(int i = 0; i < q; ++i) {
+		if(xorshift32() % 2) {
+			mo.add_update();
+			upos.push_back(xorshift32() % n);
+			uval.push_back(xorshift32() % n);
+		}
+		else {
+			int l = xorshift32() % n, r = xorshift32() % n;
+			if(l > r) std::swap(l, r);
+			mo.add_query(l, r + 1);
+		}
+	}
+	vector<int> cnt(n), res(mo.size());
+	int distinct = 0;
+	auto add = [&](size_t i) { distinct += (cnt[a[i]]++ == 0); };
+	auto remove = [&](size_t i) { distinct -= (--cnt[a[i]] == 0); };
+	// applying an update swaps the value in the array with the one in the update, so reverting it is the same operation
+	auto toggle = [&](size_t u, size_t l, size_t r) {
+		size_t pos = upos[u];
+		if(l <= pos && pos < r) {
+			remove(pos);
+			swap(a[pos], uval[u]);
+			add(pos);
+		}
+		else {
+			swap(a[pos], uval[u]);
+		}
+	};
+	chrono::system_clock::time_point start = chrono::system_clock::now();
+	mo.run(add, add, remove, remove, toggle, toggle, [&](size_t k) { res[k] = distinct; });
+	chrono::system_clock::time_point finish = chrono::system_clock::now();
+	long long sum = 0;
+	for(int i = 0; i < int(res.size()); ++i) {
+		sum += res[i];
+	}
+	cout.precision(12);
+	std::chrono::duration<double> duration = finish - start;
+	cout << "---------- UPDATE TEST RESUTLTS (# of Elements = " << n << ", # of Operations = " << q << ") ----------" << endl;
+	cout << "Answer: " << sum << endl;
+	cout << fixed << "Running: " << duration.count() << " seconds (" << duration.count() / q << " seconds per operation, pointer travel = " << mo.pointer_travel() << ")" << endl;
+}
+int main() {
+	for(int i = 16; i <= 22; i += 2) {
+		test(1 << i, 1 << i);
+		test(1 << i, 1 << (i - 4));
+	}
+	for(int i = 12; i <= 18; i += 2) {
+		test_update(1 << i, 1 << i);
+	}
+	return 0;
+}
\ No newline at end of file
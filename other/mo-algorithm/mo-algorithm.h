@@ -0,0 +1,135 @@
+#ifndef CLASS_MO_ALGORITHM
+#define CLASS_MO_ALGORITHM
+
+#include <cmath>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+class mo_scheduler {
+	// Mo's algorithm for offline queries on ranges [l, r) of an array of size n: the queries are sorted, and the window moves
+	// from one query to the next by the callbacks, which add or remove one element at an end of the window
+	// The queries are sorted by the order of the Hilbert curve on (l, r), so that the total pointer travel is O(n sqrt(q))
+	// with a smaller constant than the order of blocks, and consecutive queries are also close in both l and r
+private:
+	std::size_t n;
+	std::vector<std::uint32_t> ql, qr;
+	std::uint64_t travel;
+	static std::uint64_t hilbert_order(std::uint32_t x, std::uint32_t y, std::size_t lg) {
+		// index of (x, y) on the Hilbert curve over [0, 2^lg)^2
+		std::uint64_t d = 0;
+		for (std::uint32_t s = std::uint32_t(1) << (lg - 1); s > 0; s >>= 1) {
+			std::uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+			d += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+			if (ry == 0) {
+				// rotate the quadrant, so that the curve inside it has the same shape as the whole
+				if (rx == 1) x = s - 1 - (x & (s - 1)), y = s - 1 - (y & (s - 1));
+				std::swap(x, y);
+			}
+		}
+		return d;
+	}
+public:
+	explicit mo_scheduler() : n(0), travel(0) {};
+	explicit mo_scheduler(std::size_t n_) : n(n_), travel(0) {};
+	std::size_t add_query(std::size_t l, std::size_t r) {
+		// registers a query of [l, r), and returns its index, which is passed to the callback of the answer
+		assert(0 <= l && l <= r && r <= n);
+		ql.push_back(std::uint32_t(l));
+		qr.push_back(std::uint32_t(r));
+		return ql.size() - 1;
+	}
+	std::size_t size() const { return ql.size(); }
+	std::uint64_t pointer_travel() const {
+		// the total number of callbacks of add and remove in the last run(), for tuning
+		return travel;
+	}
+	template <class AddLeft, class AddRight, class RemoveLeft, class RemoveRight, class Answer>
+	void run(AddLeft add_left, AddRight add_right, RemoveLeft remove_left, RemoveRight remove_right, Answer answer) {
+		// add_left(i) / add_right(i): the element i enters the window at the left / right end
+		// remove_left(i) / remove_right(i): the element i leaves the window at the left / right end
+		// answer(k): the window is the range of the query k
+		std::size_t q = ql.size(), lg = 1;
+		while ((std::size_t(1) << lg) <= n) ++lg;
+		std::vector<std::pair<std::uint64_t, std::uint32_t> > order(q);
+		for (std::size_t i = 0; i < q; ++i) order[i] = std::make_pair(hilbert_order(ql[i], qr[i], lg), std::uint32_t(i));
+		std::sort(order.begin(), order.end());
+		std::size_t l = 0, r = 0;
+		travel = 0;
+		for (std::size_t j = 0; j < q; ++j) {
+			std::size_t k = order[j].second;
+			// the window grows first, so that it is never a negative range
+			travel += (l > ql[k] ? l - ql[k] : ql[k] - l) + (r > qr[k] ? r - qr[k] : qr[k] - r);
+			while (l > ql[k]) add_left(--l);
+			while (r < qr[k]) add_right(r++);
+			while (l < ql[k]) remove_left(l++);
+			while (r > qr[k]) remove_right(--r);
+			answer(k);
+		}
+	}
+};
+
+class mo_update_scheduler {
+	// Mo's algorithm with updates: each query also has a time (the number of updates before it), and the updates are
+	// applied or reverted while the window moves in time; the queries are sorted by (block of l, block of r, time) with
+	// alternating directions, and the block size is about (2 n^2 T / Q)^(1/3), which balances the travel in space and time
+private:
+	std::size_t n, updates, block;
+	std::vector<std::uint32_t> ql, qr, qt;
+	std::uint64_t travel;
+public:
+	explicit mo_update_scheduler() : n(0), updates(0), block(0), travel(0) {};
+	explicit mo_update_scheduler(std::size_t n_, std::size_t block_ = 0) : n(n_), updates(0), block(block_), travel(0) {};
+	std::size_t add_update() {
+		// registers an update at the current time, and returns its index, which is passed to the callbacks of updates
+		return updates++;
+	}
+	std::size_t add_query(std::size_t l, std::size_t r) {
+		// registers a query of [l, r) after all updates registered so far
+		assert(0 <= l && l <= r && r <= n);
+		ql.push_back(std::uint32_t(l));
+		qr.push_back(std::uint32_t(r));
+		qt.push_back(std::uint32_t(updates));
+		return ql.size() - 1;
+	}
+	std::size_t size() const { return ql.size(); }
+	std::uint64_t pointer_travel() const { return travel; }
+	template <class AddLeft, class AddRight, class RemoveLeft, class RemoveRight, class Apply, class Revert, class Answer>
+	void run(AddLeft add_left, AddRight add_right, RemoveLeft remove_left, RemoveRight remove_right, Apply apply, Revert revert, Answer answer) {
+		// apply(u, l, r) / revert(u, l, r): the update u is applied / reverted while the window is [l, r)
+		// the other callbacks are the same as mo_scheduler
+		std::size_t q = ql.size();
+		std::size_t b = block;
+		if (b == 0) {
+			double optimal = std::cbrt(2.0 * double(n) * double(n) * double(std::max<std::size_t>(updates, 1)) / double(std::max<std::size_t>(q, 1)));
+			b = std::max<std::size_t>(1, std::min<std::size_t>(std::max<std::size_t>(n, 1), std::size_t(optimal)));
+		}
+		std::vector<std::uint32_t> order(q);
+		for (std::size_t i = 0; i < q; ++i) order[i] = std::uint32_t(i);
+		std::sort(order.begin(), order.end(), [&](std::uint32_t i, std::uint32_t j) {
+			std::size_t li = ql[i] / b, lj = ql[j] / b;
+			if (li != lj) return li < lj;
+			std::size_t ri = qr[i] / b, rj = qr[j] / b;
+			if (ri != rj) return (li & 1) ? ri > rj : ri < rj;
+			return ((li + ri) & 1) ? qt[i] > qt[j] : qt[i] < qt[j];
+		});
+		std::size_t l = 0, r = 0, t = 0;
+		travel = 0;
+		for (std::size_t j = 0; j < q; ++j) {
+			std::size_t k = order[j];
+			travel += (l > ql[k] ? l - ql[k] : ql[k] - l) + (r > qr[k] ? r - qr[k] : qr[k] - r) + (t > qt[k] ? t - qt[k] : qt[k] - t);
+			while (l > ql[k]) add_left(--l);
+			while (r < qr[k]) add_right(r++);
+			while (l < ql[k]) remove_left(l++);
+			while (r > qr[k]) remove_right(--r);
+			while (t < qt[k]) apply(t, l, r), ++t;
+			while (t > qt[k]) --t, revert(t, l, r);
+			answer(k);
+		}
+	}
+};
+
+#endif // CLASS_MO_ALGORITHM
\ No newline at end of file